@@ -93,11 +93,73 @@ void BSP_InitClocks()
 	RCCHelper::SelectSystemClockFromPLL1();
 }
 
+/**
+	@brief Arm a TIM2 channel 1 compare match so the idle main loop can sleep until the next deadline
+
+	CC1 is left in frozen output compare mode, so this has no effect on any pins.
+ */
+bool BSP_ArmWakeupTimer(uint32_t target)
+{
+	const uint32_t tim2IRQ = 28;
+
+	TIM2.CCR1 = target;
+	TIM2.SR = ~0x2;			//clear stale CC1IF
+	TIM2.DIER |= 0x2;		//CC1IE
+	EnableWakeOnPendingIRQ(tim2IRQ);
+	return true;
+}
+
+void BSP_DisarmWakeupTimer()
+{
+	const uint32_t tim2IRQ = 28;
+
+	TIM2.DIER &= ~0x2;
+	TIM2.SR = ~0x2;
+	ClearPendingIRQ(tim2IRQ);
+}
+
+#ifdef LOG_UART_DMA
+BufferedLogDevice g_logBuffer(&g_logDMA);
+CharacterDevice& g_consoleOutput = g_logBuffer;
+
+/**
+	@brief Handles the g_logDMA stream interrupt: starts the next chunk of log data as soon as the last one is sent
+
+	The application must call this from the DMA1 stream IRQ handler for g_logDMA's stream.
+ */
+void BSP_OnLogDMAInterrupt()
+{
+	g_logDMA.OnInterrupt();
+	g_logBuffer.Service();
+}
+#else
+CharacterDevice& g_consoleOutput = g_cliUART;
+#endif
+
 void BSP_InitLog()
 {
-	static LogSink<MAX_LOG_SINKS> sink(&g_cliUART);
+	//With LOG_UART_DMA, g_log only copies into RAM and the DMA drains it to the UART in the background
+	#ifdef LOG_UART_DMA
+		g_logDMA.Initialize();
+		g_logDMA.EnableInterrupt();
+		EnableIRQ(g_logDMA.GetIRQ());
+		static LogSink<MAX_LOG_SINKS> sink(&g_logBuffer);
+	#else
+		static LogSink<MAX_LOG_SINKS> sink(&g_cliUART);
+	#endif
 	g_logSink = &sink;
 
+	//Mirror the log into retained memory so the bootloader can show it after a crash
+	//(the application must power up the region, e.g. backup SRAM, in BSP_InitMemory()).
+	//The bootloader only reads the region: writing its own boot messages would unseal the log it's about to dump.
+	#ifdef RETAINED_LOG_BASE
+		if(!IsBootloader())
+		{
+			g_retainedLog.Initialize();
+			sink.AddSink(&g_retainedLog);
+		}
+	#endif
+
 	g_log.Initialize(g_logSink, &g_logTimer);
 	g_log("Firmware compiled at %s on %s\n", __TIME__, __DATE__);
 }
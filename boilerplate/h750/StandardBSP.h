@@ -38,6 +38,36 @@ void DoInitKVS();
 void InitRTCFromHSE();
 
 extern UART<32, 256> g_cliUART;
+
+#ifdef RETAINED_LOG_BASE
+#include <core/RetainedLogDevice.h>
+#endif
+
+#ifdef LOG_UART_DMA
+#include <core/BufferedLogDevice.h>
+#include <drivers/STM32H7UARTDMA.h>
+
+#ifndef HAVE_LOG_DMA_IRQ
+#error LOG_UART_DMA needs the g_logDMA stream interrupt to call BSP_OnLogDMAInterrupt() (define HAVE_LOG_DMA_IRQ)
+#endif
+
+///@brief DMA backend for log output (defined by the application, for the console UART)
+extern STM32H7UARTDMA g_logDMA;
+
+///@brief RAM buffer between g_log and g_logDMA, drained from the DMA interrupt
+extern BufferedLogDevice g_logBuffer;
+
+void BSP_OnLogDMAInterrupt();
+#endif
+
+/**
+	@brief Where console (CLI) output must be sent: g_logBuffer with LOG_UART_DMA, otherwise g_cliUART
+
+	With LOG_UART_DMA the DMA owns the UART transmit data register, so anything written to g_cliUART directly would be
+	interleaved with log output. Console input still comes from g_cliUART.
+ */
+extern CharacterDevice& g_consoleOutput;
+
 extern QuadSPI_SpiFlashInterface g_flashQspi;
 
 void InitDTS();
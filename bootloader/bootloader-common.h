@@ -35,6 +35,10 @@
 #include <peripheral/CRC.h>
 #include <peripheral/Flash.h>
 
+#ifdef RETAINED_LOG_BASE
+#include <core/RetainedLogDevice.h>
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Common globals with pointers to various regions of flash
 
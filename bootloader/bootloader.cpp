@@ -297,6 +297,68 @@ void __attribute__((noreturn)) BootApplication(const uint32_t* appVector)
 	DoBootApplication(appVector);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Crash log
+
+#ifdef RETAINED_LOG_BASE
+
+/**
+	@brief Prints whatever the application logged before it crashed, if it left a retained log
+ */
+void DumpRetainedLog()
+{
+	auto base = reinterpret_cast<const void*>(RETAINED_LOG_BASE);
+	switch(RetainedLogDevice::Check(base, RETAINED_LOG_SIZE))
+	{
+		case RETAINED_LOG_EMPTY:
+			g_log("No retained log from application\n");
+			return;
+
+		case RETAINED_LOG_UNSEALED:
+			g_log(Logger::WARNING, "Retained log was not sealed, content may be incomplete\n");
+			break;
+
+		case RETAINED_LOG_BAD_CRC:
+			g_log(Logger::WARNING, "Retained log CRC mismatch, content may be corrupted\n");
+			break;
+
+		default:
+			break;
+	}
+
+	uint32_t len = RetainedLogDevice::GetLength(base);
+	g_log("Last %u bytes of application log:\n", len);
+	LogIndenter li(g_log);
+
+	//Print line by line so the output gets our indentation (the first line is probably partial, once the ring wraps)
+	char line[128];
+	uint32_t nline = 0;
+	for(uint32_t i=0; i<len; i++)
+	{
+		char c;
+		RetainedLogDevice::Read(base, i, &c, 1);
+
+		if( (c == '\n') || (nline == sizeof(line) - 1) )
+		{
+			line[nline] = '\0';
+			g_log("%s\n", line);
+			nline = 0;
+
+			//discard any commands that showed up while we were busy
+			Bootloader_ClearRxBuffer();
+		}
+		if(c != '\n')
+			line[nline++] = c;
+	}
+	if(nline)
+	{
+		line[nline] = '\0';
+		g_log("%s\n", line);
+	}
+}
+
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Top level main loop for the bootloader
 
@@ -355,6 +417,10 @@ void __attribute__((noreturn)) Bootloader_MainLoop()
 						g_log(Logger::ERROR, "Unknown crash code\n");
 						break;
 				}
+
+				#ifdef RETAINED_LOG_BASE
+					DumpRetainedLog();
+				#endif
 				break;
 
 			default:
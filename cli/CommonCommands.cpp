@@ -336,6 +336,184 @@ void RemoveFlashKey(CLIOutputStream* stream, const char* key)
 		stream->Printf("Object \"%s\" not found, could not delete\n", key);
 }
 
+/**
+	@brief Print busy/idle time accounting for the main loop
+ */
+void PrintMainLoopStats(CLIOutputStream* stream)
+{
+	if(g_mainLoopMode == MAINLOOP_POLL)
+	{
+		stream->Printf("Main loop is in polling mode, no idle accounting available\n");
+		return;
+	}
+
+	//Timer ticks are 100us
+	uint64_t busy = g_mainLoopStats.m_busyTicks;
+	uint64_t idle = g_mainLoopStats.m_idleTicks;
+	uint64_t total = busy + idle;
+	if(total == 0)
+		total = 1;
+
+	stream->Printf("Main loop is in idle mode (max sleep %d.%d ms)\n", g_mainLoopMaxIdle / 10, g_mainLoopMaxIdle % 10);
+	stream->Printf("    Busy:   %10u ms (%d %%)\n", static_cast<uint32_t>(busy / 10), static_cast<int>(busy * 100 / total));
+	stream->Printf("    Idle:   %10u ms (%d %%)\n", static_cast<uint32_t>(idle / 10), static_cast<int>(idle * 100 / total));
+	stream->Printf("    Sleeps: %10u\n", g_mainLoopStats.m_sleeps);
+}
+
+/**
+	@brief Print the deadline, period, and overrun count of each timer task in a list
+ */
+static void PrintTimerTaskList(CLIOutputStream* stream, etl::ivector<TimerTask*>& timers)
+{
+	static const char* modes[] = { "delay", "catchup", "skip" };
+
+	auto now = g_timebase.GetTicks();
+
+	stream->Printf("Idx  Task      Mode       Period      Due in    Overruns\n");
+	for(size_t i=0; i<timers.size(); i++)
+	{
+		auto t = timers[i];
+		stream->Printf("%3d  " PTR_FMT "  %-7s  %8u  %10d  %10u\n",
+			static_cast<int>(i),
+			PTR_ARGS(t),
+			modes[t->GetMode()],
+			t->GetPeriod(),
+			static_cast<int>(static_cast<int64_t>(t->GetTarget() - now)),
+			t->GetOverruns());
+	}
+}
+
+/**
+	@brief Print the deadline, period, and overrun count of each timer task
+ */
+void PrintTimerTasks(CLIOutputStream* stream)
+{
+	#ifdef MULTICORE
+		for(uint32_t core=0; core<NUM_SECONDARY_CORES; core++)
+		{
+			stream->Printf("Core %u:\n", core);
+			PrintTimerTaskList(stream, g_timerTasks[core]);
+		}
+	#else
+		PrintTimerTaskList(stream, g_timerTasks);
+	#endif
+}
+
+#ifdef TASK_PROFILE
+
+/**
+	@brief Print one row of the task profile table
+
+	There's no RTTI, so tasks are identified by address and vtable (look the vtable up in the symbol table to get the
+	class name)
+ */
+static void PrintTaskProfileLine(CLIOutputStream* stream, const char* type, int idx, Task* t)
+{
+	auto& p = t->m_profile;
+	uint32_t avg = 0;
+	if(p.m_calls)
+		avg = p.m_totalCycles / p.m_calls;
+
+	stream->Printf("%-5s %3d  " PTR_FMT "  " PTR_FMT "  %10u  %10u  %10u",
+		type,
+		idx,
+		PTR_ARGS(t),
+		PTR_ARGS(*reinterpret_cast<void**>(t)),
+		p.m_calls,
+		avg,
+		p.m_maxCycles);
+	for(int i=0; i<TASK_PROFILE_BINS; i++)
+		stream->Printf(" %8u", p.m_histogram[i]);
+	stream->Printf("\n");
+}
+
+/**
+	@brief Print per-task execution time statistics
+ */
+void PrintTaskProfile(CLIOutputStream* stream)
+{
+	stream->Printf("Type  Idx  Task      Vtable         Calls  Avg cycles  Max cycles"
+		"      <64     <256      <1K      <4K     <16K     <64K    <256K   >=256K\n");
+
+	#ifdef MULTICORE
+		for(uint32_t core=0; core<NUM_SECONDARY_CORES; core++)
+		{
+			stream->Printf("Core %u:\n", core);
+			for(size_t i=0; i<g_tasks[core].size(); i++)
+				PrintTaskProfileLine(stream, "task", i, g_tasks[core][i]);
+			for(size_t i=0; i<g_timerTasks[core].size(); i++)
+				PrintTaskProfileLine(stream, "timer", i, g_timerTasks[core][i]);
+		}
+	#else
+		for(size_t i=0; i<g_tasks.size(); i++)
+			PrintTaskProfileLine(stream, "task", i, g_tasks[i]);
+		for(size_t i=0; i<g_timerTasks.size(); i++)
+			PrintTaskProfileLine(stream, "timer", i, g_timerTasks[i]);
+	#endif
+}
+
+/**
+	@brief Clear all task execution time statistics
+ */
+void ResetTaskProfile()
+{
+	#ifdef MULTICORE
+		for(uint32_t core=0; core<NUM_SECONDARY_CORES; core++)
+		{
+			for(auto t : g_tasks[core])
+				t->m_profile.Reset();
+			for(auto t : g_timerTasks[core])
+				t->m_profile.Reset();
+		}
+	#else
+		for(auto t : g_tasks)
+			t->m_profile.Reset();
+		for(auto t : g_timerTasks)
+			t->m_profile.Reset();
+	#endif
+}
+
+#endif
+
+/**
+	@brief Print the current and default level of every log category
+ */
+void PrintLogLevels(CLIOutputStream* stream)
+{
+	stream->Printf("Category         Level    Default\n");
+	for(auto cat = LogCategory::GetFirst(); cat != nullptr; cat = cat->GetNext())
+	{
+		stream->Printf("%-16s %-8s %s\n",
+			cat->GetName(),
+			LogCategory::GetLevelName(cat->GetLevel()),
+			LogCategory::GetLevelName(cat->GetDefaultLevel()));
+	}
+}
+
+/**
+	@brief Change the level of a log category
+
+	Takes effect immediately. Call LogCategory::SaveConfigToKVS() (typically from the "commit" command) to persist it.
+ */
+void SetLogLevel(CLIOutputStream* stream, const char* category, const char* level)
+{
+	auto cat = LogCategory::Find(category);
+	if(!cat)
+	{
+		stream->Printf("No log category named \"%s\"\n", category);
+		return;
+	}
+
+	LogLevel l;
+	if(!LogCategory::ParseLevel(level, l))
+	{
+		stream->Printf("Usage: log level <category> [off|error|warning|notice|verbose|debug]\n");
+		return;
+	}
+
+	cat->SetLevel(l);
+}
+
 #ifdef CEP_BUILD_TCPIP
 
 void PrintSSHHostKey(CLIOutputStream* stream)
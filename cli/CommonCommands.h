@@ -52,6 +52,17 @@ void PrintFlashSummary(CLIOutputStream* stream);
 void PrintFlashDetails(CLIOutputStream* stream, const char* objectName);
 void RemoveFlashKey(CLIOutputStream* stream, const char* key);
 
+void PrintMainLoopStats(CLIOutputStream* stream);
+void PrintTimerTasks(CLIOutputStream* stream);
+
+void PrintLogLevels(CLIOutputStream* stream);
+void SetLogLevel(CLIOutputStream* stream, const char* category, const char* level);
+
+#ifdef TASK_PROFILE
+void PrintTaskProfile(CLIOutputStream* stream);
+void ResetTaskProfile();
+#endif
+
 #ifdef CEP_BUILD_TCPIP
 void PrintSSHHostKey(CLIOutputStream* stream);
 
@@ -0,0 +1,196 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include "BufferedLogDevice.h"
+
+/**
+	@file
+	@brief Implementation of BufferedLogDevice
+ */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction / destruction
+
+BufferedLogDevice::BufferedLogDevice(LogTxBackend* backend, LogOverflowPolicy policy)
+	: m_backend(backend)
+	, m_policy(policy)
+	, m_head(0)
+	, m_tail(0)
+	, m_next(0)
+	, m_drops(0)
+	, m_overwrites(0)
+	, m_blocks(0)
+	, m_highWater(0)
+{
+	m_pending[0] = 0;
+	m_pending[1] = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Logging
+
+/**
+	@brief Adds data to the ring, applying the overflow policy if there isn't room for all of it
+ */
+void BufferedLogDevice::Write(const char* buf, uint32_t len)
+{
+	//Never wait for more than the ring can hold
+	if(len > LOG_BUFFER_SIZE)
+	{
+		if(m_policy == LOG_OVERFLOW_OVERWRITE)
+		{
+			m_overwrites += len - LOG_BUFFER_SIZE;
+			buf += len - LOG_BUFFER_SIZE;
+		}
+		else
+			m_drops += len - LOG_BUFFER_SIZE;
+		len = LOG_BUFFER_SIZE;
+	}
+
+	//Wait for the backend to make room, if we're allowed to
+	if(m_policy == LOG_OVERFLOW_BLOCK)
+	{
+		bool blocked = false;
+		while( (LOG_BUFFER_SIZE - (m_head - m_tail)) < len)
+		{
+			blocked = true;
+			Service();
+		}
+		if(blocked)
+			m_blocks ++;
+	}
+
+	//Service() may run from an interrupt, and moves m_tail
+	{
+		InterruptGuard guard;
+
+		uint32_t space = LOG_BUFFER_SIZE - (m_head - m_tail);
+		if(len > space)
+		{
+			if(m_policy == LOG_OVERFLOW_OVERWRITE)
+			{
+				m_overwrites += len - space;
+				m_tail += len - space;
+			}
+			else
+			{
+				m_drops += len - space;
+				len = space;
+			}
+		}
+
+		//Copy in up to two pieces, if we wrap
+		uint32_t offset = m_head & (LOG_BUFFER_SIZE - 1);
+		uint32_t first = LOG_BUFFER_SIZE - offset;
+		if(first > len)
+			first = len;
+		memcpy(m_ring + offset, buf, first);
+		memcpy(m_ring, buf + first, len - first);
+		m_head += len;
+
+		uint32_t used = m_head - m_tail;
+		if(used > m_highWater)
+			m_highWater = used;
+	}
+
+	//Start sending right away if the backend is idle, since no transfer complete interrupt is coming to do it
+	Service();
+}
+
+void BufferedLogDevice::PrintBinary(char ch)
+{
+	Write(&ch, 1);
+}
+
+void BufferedLogDevice::PrintString(const char* str)
+{
+	Write(str, strlen(str));
+}
+
+char BufferedLogDevice::BlockingRead()
+{
+	return 0;
+}
+
+void BufferedLogDevice::Flush()
+{
+	Service();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Transmit path
+
+/**
+	@brief Moves up to LOG_TX_CHUNK_SIZE bytes from the ring into a transmit buffer
+
+	@return Number of bytes moved
+ */
+uint32_t BufferedLogDevice::Fill(uint8_t* buf)
+{
+	uint32_t len = m_head - m_tail;
+	if(len > LOG_TX_CHUNK_SIZE)
+		len = LOG_TX_CHUNK_SIZE;
+
+	uint32_t offset = m_tail & (LOG_BUFFER_SIZE - 1);
+	uint32_t first = LOG_BUFFER_SIZE - offset;
+	if(first > len)
+		first = len;
+	memcpy(buf, m_ring + offset, first);
+	memcpy(buf + first, m_ring, len - first);
+
+	m_tail += len;
+	return len;
+}
+
+/**
+	@brief Starts the next transfer if the backend is idle, and fills the idle transmit buffer if it isn't
+ */
+void BufferedLogDevice::Service()
+{
+	InterruptGuard guard;
+
+	//Previous transfer is done, start the next one
+	if(!m_backend->IsBusy())
+	{
+		if(m_pending[m_next] == 0)
+			m_pending[m_next] = Fill(m_txBuffers[m_next]);
+
+		if(m_pending[m_next] != 0)
+		{
+			m_backend->Start(m_txBuffers[m_next], m_pending[m_next]);
+			m_pending[m_next] = 0;
+			m_next ^= 1;
+		}
+	}
+
+	//Get the other buffer ready while this one is in flight
+	if(m_pending[m_next] == 0)
+		m_pending[m_next] = Fill(m_txBuffers[m_next]);
+}
@@ -0,0 +1,166 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef BufferedLogDevice_h
+#define BufferedLogDevice_h
+
+#include <embedded-utils/CharacterDevice.h>
+
+///@brief Size of the log ring buffer
+#ifndef LOG_BUFFER_SIZE
+#define LOG_BUFFER_SIZE 4096
+#endif
+
+static_assert( (LOG_BUFFER_SIZE & (LOG_BUFFER_SIZE - 1)) == 0, "LOG_BUFFER_SIZE must be a power of two");
+
+///@brief Size of each of the two transmit buffers
+#ifndef LOG_TX_CHUNK_SIZE
+#define LOG_TX_CHUNK_SIZE 256
+#endif
+
+///@brief What to do when log data arrives faster than it can be sent
+enum LogOverflowPolicy
+{
+	LOG_OVERFLOW_DROP,		//discard the new data (default)
+	LOG_OVERFLOW_OVERWRITE,	//discard the oldest unsent data to make room
+	LOG_OVERFLOW_BLOCK		//wait for the backend to free up space
+};
+
+/**
+	@brief Something that can send a block of data in the background, typically a UART with a DMA channel
+ */
+class LogTxBackend
+{
+public:
+	///@brief Returns true if a transfer is still in progress
+	virtual bool IsBusy() =0;
+
+	/**
+		@brief Starts sending a buffer
+
+		The buffer is left untouched until IsBusy() returns false.
+	 */
+	virtual void Start(const uint8_t* buf, uint32_t len) =0;
+};
+
+/**
+	@brief Log device which only copies log data into RAM, leaving a backend to send it in the background
+
+	Log output goes into a LOG_BUFFER_SIZE ring. Service() moves it into one of two LOG_TX_CHUNK_SIZE transmit buffers
+	and starts the backend on it; while that buffer is in flight, the other one is filled so the next transfer can
+	start as soon as the current one finishes.
+
+	Service() is called after every write and by Flush(). Once a write stops, something still has to call it as each
+	transfer finishes, or the rest of the ring is never sent: either the backend's transfer complete interrupt
+	(preferred, since it also closes the gap between transfers), or a LogFlushTask polling the device.
+
+	The device object contains the transmit buffers, so it must be in memory the backend's DMA can reach (on STM32H7,
+	anywhere but the TCMs).
+ */
+class BufferedLogDevice : public CharacterDevice
+{
+public:
+	BufferedLogDevice(LogTxBackend* backend, LogOverflowPolicy policy = LOG_OVERFLOW_DROP);
+
+	void SetPolicy(LogOverflowPolicy policy)
+	{ m_policy = policy; }
+
+	void Write(const char* buf, uint32_t len);
+	void Service();
+
+	virtual void PrintBinary(char ch) override;
+	virtual void PrintString(const char* str) override;
+	virtual char BlockingRead() override;
+	virtual void Flush() override;
+
+	///@brief Number of bytes discarded under LOG_OVERFLOW_DROP
+	uint32_t GetDropCount() const
+	{ return m_drops; }
+
+	///@brief Number of unsent bytes discarded under LOG_OVERFLOW_OVERWRITE
+	uint32_t GetOverwriteCount() const
+	{ return m_overwrites; }
+
+	///@brief Number of writes which had to wait under LOG_OVERFLOW_BLOCK
+	uint32_t GetBlockCount() const
+	{ return m_blocks; }
+
+	///@brief Most bytes ever waiting in the ring
+	uint32_t GetHighWater() const
+	{ return m_highWater; }
+
+	void ClearCounters()
+	{
+		m_drops = 0;
+		m_overwrites = 0;
+		m_blocks = 0;
+		m_highWater = 0;
+	}
+
+protected:
+	uint32_t Fill(uint8_t* buf);
+
+	///@brief The backend sending our data
+	LogTxBackend* m_backend;
+
+	///@brief Overflow behavior
+	LogOverflowPolicy m_policy;
+
+	///@brief Log data waiting to be sent
+	char m_ring[LOG_BUFFER_SIZE];
+
+	///@brief Write index (free running)
+	uint32_t m_head;
+
+	///@brief Read index (free running)
+	uint32_t m_tail;
+
+	///@brief Ping-pong transmit buffers (cache line aligned, since the backend may clean them for DMA)
+	uint8_t m_txBuffers[2][LOG_TX_CHUNK_SIZE] __attribute__((aligned(32)));
+
+	///@brief Number of bytes filled but not yet started in each transmit buffer
+	uint32_t m_pending[2];
+
+	///@brief Index of the transmit buffer to start next
+	uint32_t m_next;
+
+	///@brief Bytes dropped
+	uint32_t m_drops;
+
+	///@brief Bytes overwritten
+	uint32_t m_overwrites;
+
+	///@brief Writes that had to wait
+	uint32_t m_blocks;
+
+	///@brief Ring high-water mark
+	uint32_t m_highWater;
+};
+
+#endif
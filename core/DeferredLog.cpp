@@ -0,0 +1,119 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+
+/**
+	@file
+	@brief Implementation of DeferredLog
+ */
+
+///@brief The deferred log used by DLOG()
+DeferredLog g_deferredLog;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction / destruction
+
+DeferredLog::DeferredLog()
+	: m_head(0)
+	, m_tail(0)
+	, m_drops(0)
+	, m_overflows(0)
+	, m_drainTask(nullptr)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Logging
+
+/**
+	@brief Fills out the frame header of an encoded record and copies it into the ring
+
+	@param rec	Encoded record, with three bytes of space at the start for the header
+	@param len	Total record length including the header
+ */
+void DeferredLog::Append(uint8_t* rec, uint32_t len)
+{
+	if(len > DEFERRED_LOG_MAX_RECORD)
+	{
+		m_overflows ++;
+		return;
+	}
+
+	uint16_t bodylen = len - 3;
+	rec[0] = DEFERRED_LOG_SYNC;
+	memcpy(rec + 1, &bodylen, sizeof(bodylen));
+
+	//Interrupt handlers may log too
+	InterruptGuard guard;
+
+	uint32_t head = m_head;
+	if( (head - m_tail + len) > DEFERRED_LOG_SIZE)
+	{
+		m_drops ++;
+		return;
+	}
+
+	//Copy in up to two pieces, if we wrap
+	uint32_t offset = head & (DEFERRED_LOG_SIZE - 1);
+	uint32_t first = DEFERRED_LOG_SIZE - offset;
+	if(first > len)
+		first = len;
+	memcpy(m_buffer + offset, rec, first);
+	memcpy(m_buffer, rec + first, len - first);
+
+	m_head = head + len;
+
+	if(m_drainTask)
+		m_drainTask->Wake();
+}
+
+/**
+	@brief Sends up to maxBytes of encoded records to a device
+
+	Records may be split across calls; the stream is the same either way.
+
+	@return Number of bytes sent
+ */
+uint32_t DeferredLog::Drain(CharacterDevice& target, uint32_t maxBytes)
+{
+	uint32_t tail = m_tail;
+	uint32_t avail = m_head - tail;
+	if(avail > maxBytes)
+		avail = maxBytes;
+
+	for(uint32_t i=0; i<avail; i++)
+		target.PrintBinary(m_buffer[(tail + i) & (DEFERRED_LOG_SIZE - 1)]);
+
+	//Let the producer reuse the space once we're done reading it
+	asm volatile("" ::: "memory");
+	m_tail = tail + avail;
+
+	return avail;
+}
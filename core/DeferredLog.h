@@ -0,0 +1,270 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef DeferredLog_h
+#define DeferredLog_h
+
+#include <type_traits>
+#include <embedded-utils/CharacterDevice.h>
+
+#ifndef DEFERRED_LOG_SIZE
+#define DEFERRED_LOG_SIZE 4096
+#endif
+
+static_assert( (DEFERRED_LOG_SIZE & (DEFERRED_LOG_SIZE - 1)) == 0, "DEFERRED_LOG_SIZE must be a power of two");
+
+///@brief Largest encoded log record, including the frame header (longer string arguments are truncated)
+#ifndef DEFERRED_LOG_MAX_RECORD
+#define DEFERRED_LOG_MAX_RECORD 128
+#endif
+
+///@brief Most bytes DeferredLogTask sends per iteration
+#ifndef DEFERRED_LOG_DRAIN_CHUNK
+#define DEFERRED_LOG_DRAIN_CHUNK 64
+#endif
+
+///@brief First byte of every record
+#define DEFERRED_LOG_SYNC 0xa5
+
+/**
+	@brief Binary log which stores format string addresses and raw arguments, leaving the formatting to the host
+
+	A DLOG() call costs a few word stores and a memcpy into a ring buffer, instead of a full printf, so logging can stay
+	enabled in hot paths and production builds.
+
+	Format strings are placed in the .logstrings section and identified by their address. The target never reads them,
+	so the BSP linker script should make the section non-loaded, e.g.
+	@code
+	.logstrings (INFO) : { KEEP(*(.logstrings)) }
+	@endcode
+
+	Each record is framed as:
+	* DEFERRED_LOG_SYNC
+	* 16-bit length of the rest of the record
+	* 32-bit format string address
+	* 32-bit timestamp (low half of g_timebase, in log timer ticks)
+	* Arguments, little endian and unaligned: integers of 4 bytes or less are widened to 4 bytes, 64-bit integers and
+	  floating point values (as double) are 8 bytes, pointers are native size, and strings are copied inline as an
+	  8-bit length followed by the characters
+
+	DeferredLogTask streams the records to a CharacterDevice, and tools/deferred-log-decode.py turns the stream back
+	into text using the format strings in the ELF. The task is event-driven: each new record wakes it, and it keeps
+	itself awake until the ring is empty.
+
+	Safe to call from interrupt handlers. Not safe to share between cores: use one instance per core.
+ */
+class DeferredLog
+{
+public:
+	DeferredLog();
+
+	template<typename... Args>
+	void Log(const char* fmt, Args... args)
+	{
+		uint8_t rec[DEFERRED_LOG_MAX_RECORD];
+		uint32_t len = 3;
+		PackArg(rec, len, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(fmt)));
+		PackArg(rec, len, static_cast<uint32_t>(g_timebase.GetTicks()));
+		Pack(rec, len, args...);
+		Append(rec, len);
+	}
+
+	uint32_t Drain(CharacterDevice& target, uint32_t maxBytes);
+
+	///@brief Returns true if there are records waiting to be drained
+	bool IsEmpty()
+	{ return m_head == m_tail; }
+
+	///@brief Number of records dropped because the ring was full
+	uint32_t GetDropCount()
+	{ return m_drops; }
+
+	///@brief Number of records dropped because they were longer than DEFERRED_LOG_MAX_RECORD
+	uint32_t GetOverflowCount()
+	{ return m_overflows; }
+
+	///@brief Sets the task to wake when a record is added
+	void SetDrainTask(Task* task)
+	{ m_drainTask = task; }
+
+protected:
+	void Append(uint8_t* rec, uint32_t len);
+
+	static void Pack(uint8_t* /*rec*/, uint32_t& /*len*/)
+	{}
+
+	template<typename T, typename... Rest>
+	static void Pack(uint8_t* rec, uint32_t& len, T first, Rest... rest)
+	{
+		PackArg(rec, len, first);
+		Pack(rec, len, rest...);
+	}
+
+	/**
+		@brief Appends raw bytes to a record, or marks it as overflowed if there's no room
+	 */
+	static void PackBytes(uint8_t* rec, uint32_t& len, const void* data, uint32_t size)
+	{
+		if( (len + size) > DEFERRED_LOG_MAX_RECORD)
+			len = DEFERRED_LOG_MAX_RECORD + 1;
+		else
+		{
+			memcpy(rec + len, data, size);
+			len += size;
+		}
+	}
+
+	///@brief Integers and enums: 4 bytes, or 8 for 64-bit types
+	template<typename T>
+	static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+		PackArg(uint8_t* rec, uint32_t& len, T value)
+	{
+		if(sizeof(T) > 4)
+		{
+			uint64_t v = static_cast<uint64_t>(value);
+			PackBytes(rec, len, &v, sizeof(v));
+		}
+		else
+		{
+			uint32_t v = static_cast<uint32_t>(value);
+			PackBytes(rec, len, &v, sizeof(v));
+		}
+	}
+
+	///@brief Floating point: promoted to double, as printf would
+	template<typename T>
+	static typename std::enable_if<std::is_floating_point<T>::value>::type
+		PackArg(uint8_t* rec, uint32_t& len, T value)
+	{
+		double v = value;
+		PackBytes(rec, len, &v, sizeof(v));
+	}
+
+	///@brief Strings: copied inline, since the pointer may not be valid by the time the record is decoded
+	static void PackArg(uint8_t* rec, uint32_t& len, const char* str)
+	{
+		if(len >= DEFERRED_LOG_MAX_RECORD)
+		{
+			len = DEFERRED_LOG_MAX_RECORD + 1;
+			return;
+		}
+
+		//Truncate to whatever space is left
+		uint32_t room = DEFERRED_LOG_MAX_RECORD - len - 1;
+		if(room > 255)
+			room = 255;
+		uint8_t n = strnlen(str ? str : "", room);
+		rec[len++] = n;
+		memcpy(rec + len, str, n);
+		len += n;
+	}
+
+	static void PackArg(uint8_t* rec, uint32_t& len, char* str)
+	{ PackArg(rec, len, const_cast<const char*>(str)); }
+
+	///@brief Other pointers: the address, at native size
+	static void PackArg(uint8_t* rec, uint32_t& len, const void* ptr)
+	{
+		uintptr_t v = reinterpret_cast<uintptr_t>(ptr);
+		PackBytes(rec, len, &v, sizeof(v));
+	}
+
+	///@brief The encoded records
+	uint8_t m_buffer[DEFERRED_LOG_SIZE];
+
+	///@brief Write index (free running)
+	volatile uint32_t m_head;
+
+	///@brief Read index (free running)
+	volatile uint32_t m_tail;
+
+	///@brief Records dropped due to the ring being full
+	uint32_t m_drops;
+
+	///@brief Records dropped due to being too big
+	uint32_t m_overflows;
+
+	///@brief Task to wake when a record is added (may be null)
+	Task* m_drainTask;
+};
+
+/**
+	@brief Task that streams deferred log records to a CharacterDevice, a chunk per pass through the main loop
+
+	Only runs while there are records to send.
+ */
+class DeferredLogTask : public Task
+{
+public:
+	DeferredLogTask(DeferredLog& log, CharacterDevice& target)
+		: Task(false)
+		, m_log(log)
+		, m_target(target)
+	{ m_log.SetDrainTask(this); }
+
+protected:
+	virtual void Iteration() override
+	{
+		m_log.Drain(m_target, DEFERRED_LOG_DRAIN_CHUNK);
+
+		//Come back next pass if there's more than one chunk queued
+		if(!m_log.IsEmpty())
+			Wake();
+	}
+
+	DeferredLog& m_log;
+	CharacterDevice& m_target;
+};
+
+extern DeferredLog g_deferredLog;
+
+///@brief Does nothing, but lets the compiler check DLOG() arguments against the format string
+static inline void __attribute__((format(printf, 1, 2))) DeferredLogCheckFormat(const char* /*fmt*/, ...)
+{}
+
+/**
+	@brief Logs a message
+
+	Goes to g_deferredLog in binary if DEFERRED_LOG is defined, or is formatted and sent to g_log as usual otherwise, so
+	the same calls work in both modes. The format must be a string literal.
+ */
+#ifdef DEFERRED_LOG
+	#define DLOG(fmt, ...) \
+		do \
+		{ \
+			static const char __attribute__((section(".logstrings"))) dlogFormat[] = fmt; \
+			if(false) \
+				DeferredLogCheckFormat(fmt, ##__VA_ARGS__); \
+			g_deferredLog.Log(dlogFormat, ##__VA_ARGS__); \
+		} while(0)
+#else
+	#define DLOG(fmt, ...) g_log(fmt, ##__VA_ARGS__)
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef InterruptGuard_h
+#define InterruptGuard_h
+
+/**
+	@brief Masks interrupts on the current core for as long as the object is in scope, then restores the previous state
+
+	Nests correctly, since it restores the saved mask rather than unconditionally re-enabling. Only protects against
+	interrupts on this core, not other cores.
+
+	The host simulation (see multicore/host) has no interrupts, so there it does nothing.
+ */
+class InterruptGuard
+{
+public:
+	InterruptGuard()
+	{
+		#if defined(IPC_HOST_SIMULATION)
+			m_flags = 0;
+		#elif defined(__aarch64__)
+			asm volatile("mrs %0, daif" : "=r"(m_flags));
+			asm volatile("msr daifset, #3" ::: "memory");
+		#else
+			asm volatile("mrs %0, primask" : "=r"(m_flags));
+			asm volatile("cpsid i" ::: "memory");
+		#endif
+	}
+
+	~InterruptGuard()
+	{
+		#if defined(IPC_HOST_SIMULATION)
+		#elif defined(__aarch64__)
+			asm volatile("msr daif, %0" :: "r"(m_flags) : "memory");
+		#else
+			asm volatile("msr primask, %0" :: "r"(m_flags) : "memory");
+		#endif
+	}
+
+	InterruptGuard(const InterruptGuard&) = delete;
+	InterruptGuard& operator=(const InterruptGuard&) = delete;
+
+protected:
+
+	///@brief Saved interrupt mask state
+	uintptr_t m_flags;
+};
+
+#endif
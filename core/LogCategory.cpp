@@ -0,0 +1,135 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include <embedded-utils/StringBuffer.h>
+
+/**
+	@file
+	@brief Implementation of LogCategory
+ */
+
+LogCategory* LogCategory::m_first = nullptr;
+
+static const char* g_logLevelNames[] =
+{
+	"off",
+	"error",
+	"warning",
+	"notice",
+	"verbose",
+	"debug"
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction / destruction
+
+/**
+	@brief Creates a category and adds it to the list of all categories
+
+	Categories are normally globals, so this runs during static initialization, before the KVS is up. The default level
+	applies until LoadConfigFromKVS() is called.
+ */
+LogCategory::LogCategory(const char* name, LogLevel defaultLevel)
+	: m_level(defaultLevel)
+	, m_defaultLevel(defaultLevel)
+	, m_name(name)
+	, m_next(m_first)
+{
+	m_first = this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Lookup
+
+///@brief Finds a category by name, returning nullptr if there's no such category
+LogCategory* LogCategory::Find(const char* name)
+{
+	for(auto cat = m_first; cat != nullptr; cat = cat->m_next)
+	{
+		if(!strcmp(cat->m_name, name))
+			return cat;
+	}
+	return nullptr;
+}
+
+const char* LogCategory::GetLevelName(LogLevel level)
+{
+	if(static_cast<uint32_t>(level) > LOG_LEVEL_DEBUG)
+		return "invalid";
+	return g_logLevelNames[level];
+}
+
+///@brief Parses a level name, as printed by GetLevelName()
+bool LogCategory::ParseLevel(const char* name, LogLevel& level)
+{
+	for(uint32_t i=0; i<=LOG_LEVEL_DEBUG; i++)
+	{
+		if(!strcmp(g_logLevelNames[i], name))
+		{
+			level = static_cast<LogLevel>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Serialization
+
+///@brief Gets the KVS key for this category's level
+void LogCategory::FormatKey(char* key)
+{
+	memset(key, 0, KVS_NAMELEN+1);
+	StringBuffer buf(key, KVS_NAMELEN);
+	buf.Printf("log.%s", m_name);
+}
+
+void LogCategory::LoadConfigFromKVS()
+{
+	char key[KVS_NAMELEN+1];
+	for(auto cat = m_first; cat != nullptr; cat = cat->m_next)
+	{
+		cat->FormatKey(key);
+		auto level = g_kvs->ReadObject<uint8_t>(cat->m_defaultLevel, key);
+		if(level <= LOG_LEVEL_DEBUG)
+			cat->m_level = level;
+	}
+}
+
+void LogCategory::SaveConfigToKVS()
+{
+	char key[KVS_NAMELEN+1];
+	for(auto cat = m_first; cat != nullptr; cat = cat->m_next)
+	{
+		cat->FormatKey(key);
+		if(!g_kvs->StoreObjectIfNecessary<uint8_t>(cat->m_level, cat->m_defaultLevel, key))
+			g_log(Logger::ERROR, "KVS write error\n");
+	}
+}
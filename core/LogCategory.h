@@ -0,0 +1,138 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef LogCategory_h
+#define LogCategory_h
+
+#include <stdint.h>
+
+/**
+	@file
+	@brief Per-subsystem log verbosity
+
+	Each subsystem declares a LogCategory with a short name and a default level, then logs through the LOG_xxx()
+	macros instead of calling g_log directly:
+	@code
+	static LogCategory g_fooLog("foo", LOG_LEVEL_NOTICE);
+	...
+	LOG_VERBOSE(g_fooLog, "Got %d bytes\n", len);
+	@endcode
+
+	Levels can be changed at runtime with SetLevel() and are persisted in the KVS as "log.<name>" by
+	SaveConfigToKVS(); InitKVS() loads them at boot. Keep names short enough for the key to fit the KVS name length.
+
+	Statements above LOG_COMPILE_LEVEL are removed at compile time. The rest cost one load and compare when disabled.
+	LOG_COMPILE_LEVEL may be set for the whole build, or per translation unit by defining it before including
+	platform.h.
+ */
+
+enum LogLevel
+{
+	LOG_LEVEL_OFF		= 0,
+	LOG_LEVEL_ERROR		= 1,
+	LOG_LEVEL_WARNING	= 2,
+	LOG_LEVEL_NOTICE	= 3,	//normal operational messages
+	LOG_LEVEL_VERBOSE	= 4,	//extra detail for debugging a subsystem
+	LOG_LEVEL_DEBUG		= 5		//detailed tracing and profiling
+};
+
+///@brief Most verbose level compiled in
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+class LogCategory
+{
+public:
+	LogCategory(const char* name, LogLevel defaultLevel);
+
+	///@brief Returns true if messages at the given level should be printed
+	bool IsEnabled(LogLevel level) const
+	{ return level <= m_level; }
+
+	LogLevel GetLevel() const
+	{ return static_cast<LogLevel>(m_level); }
+
+	LogLevel GetDefaultLevel() const
+	{ return static_cast<LogLevel>(m_defaultLevel); }
+
+	void SetLevel(LogLevel level)
+	{ m_level = level; }
+
+	const char* GetName() const
+	{ return m_name; }
+
+	LogCategory* GetNext()
+	{ return m_next; }
+
+	static LogCategory* GetFirst()
+	{ return m_first; }
+
+	static LogCategory* Find(const char* name);
+
+	static void LoadConfigFromKVS();
+	static void SaveConfigToKVS();
+
+	static const char* GetLevelName(LogLevel level);
+	static bool ParseLevel(const char* name, LogLevel& level);
+
+protected:
+	void FormatKey(char* key);
+
+	///@brief Current level (one byte, so checking it is a single load)
+	uint8_t m_level;
+
+	///@brief Level used if nothing is stored in the KVS
+	uint8_t m_defaultLevel;
+
+	///@brief Short name, used as the KVS key suffix and on the CLI
+	const char* m_name;
+
+	///@brief Next category in the list of all categories
+	LogCategory* m_next;
+
+	///@brief Head of the list of all categories (built by the constructors)
+	static LogCategory* m_first;
+};
+
+///@brief True if a statement at this level in this category would print (use to guard expensive setup, like timing)
+#define LOG_ENABLED(cat, level) ( ((level) <= LOG_COMPILE_LEVEL) && (cat).IsEnabled(level) )
+
+#define LOG_ERROR(cat, ...) \
+	do { if(LOG_ENABLED(cat, LOG_LEVEL_ERROR)) g_log(Logger::ERROR, __VA_ARGS__); } while(0)
+#define LOG_WARNING(cat, ...) \
+	do { if(LOG_ENABLED(cat, LOG_LEVEL_WARNING)) g_log(Logger::WARNING, __VA_ARGS__); } while(0)
+#define LOG_NOTICE(cat, ...) \
+	do { if(LOG_ENABLED(cat, LOG_LEVEL_NOTICE)) g_log(__VA_ARGS__); } while(0)
+#define LOG_VERBOSE(cat, ...) \
+	do { if(LOG_ENABLED(cat, LOG_LEVEL_VERBOSE)) g_log(__VA_ARGS__); } while(0)
+#define LOG_DEBUG(cat, ...) \
+	do { if(LOG_ENABLED(cat, LOG_LEVEL_DEBUG)) g_log(__VA_ARGS__); } while(0)
+
+#endif
@@ -34,6 +34,9 @@
 
 /**
 	@brief Task that flushes log buffers each iteration through the main loop
+
+	Always polled, since a generic CharacterDevice has no way to tell us when it has buffered data. Devices that can
+	drain themselves from an interrupt (e.g. BufferedLogDevice with an interrupt-driven backend) don't need one.
  */
 class LogFlushTask : public Task
 {
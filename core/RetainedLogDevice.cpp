@@ -0,0 +1,274 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include "RetainedLogDevice.h"
+
+/**
+	@file
+	@brief Implementation of RetainedLogDevice
+ */
+
+#ifdef RETAINED_LOG_BASE
+RetainedLogDevice g_retainedLog(reinterpret_cast<void*>(RETAINED_LOG_BASE), RETAINED_LOG_SIZE);
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction / destruction
+
+/**
+	@brief Creates a log device on top of a retained memory region
+
+	Nothing is written to the region until Initialize() is called, so the object can be a global constructed before
+	the region is powered up.
+
+	@param base		Start of the region
+	@param size		Size of the region, including the header
+ */
+RetainedLogDevice::RetainedLogDevice(void* base, uint32_t size)
+	: m_header(reinterpret_cast<volatile RetainedLogHeader*>(base))
+	, m_ring(reinterpret_cast<char*>(base) + sizeof(RetainedLogHeader))
+	, m_ringSize(size - sizeof(RetainedLogHeader))
+	, m_offset(0)
+	, m_length(0)
+	, m_active(false)
+{
+}
+
+/**
+	@brief Picks up an existing log in the region, or starts a new one if there isn't a usable one
+
+	Keeping the old content means the log leading up to a crash is still there if the next boot crashes too.
+ */
+void RetainedLogDevice::Initialize()
+{
+	m_active = true;
+
+	if(Check(const_cast<RetainedLogHeader*>(m_header), m_ringSize + sizeof(RetainedLogHeader)) == RETAINED_LOG_EMPTY)
+		Clear();
+	else
+	{
+		m_offset = m_header->m_offset;
+		m_length = m_header->m_length;
+		m_header->m_sealed = 0;
+	}
+}
+
+///@brief Discards all retained content
+void RetainedLogDevice::Clear()
+{
+	m_offset = 0;
+	m_length = 0;
+
+	m_header->m_magic = RETAINED_LOG_MAGIC;
+	m_header->m_ringSize = m_ringSize;
+	m_header->m_offset = 0;
+	m_header->m_length = 0;
+	m_header->m_check = ~0;
+	m_header->m_sealed = 0;
+	m_header->m_crc = 0;
+}
+
+/**
+	@brief Computes the CRC over the retained content, so the bootloader can tell it's intact
+
+	Call from a fault handler or right before a deliberate reset. Any later write unseals the log again.
+
+	Does nothing before Initialize(), e.g. when called from the bootloader's Reset(), so a log left behind by the
+	application isn't marked as verified by code that never wrote it.
+ */
+void RetainedLogDevice::Seal()
+{
+	if(!m_active)
+		return;
+
+	InterruptGuard guard;
+
+	m_header->m_crc = CRC32(reinterpret_cast<const uint8_t*>(m_ring), m_ringSize);
+	m_header->m_sealed = RETAINED_LOG_SEALED;
+
+	//Make sure everything is actually in RAM before the reset
+	#ifdef HAVE_L1
+		CleanDataCache(const_cast<RetainedLogHeader*>(m_header), m_ringSize + sizeof(RetainedLogHeader));
+	#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Logging
+
+/**
+	@brief Appends data to the ring, overwriting the oldest content once it's full
+ */
+void RetainedLogDevice::Write(const char* buf, uint32_t len)
+{
+	//Only the tail end of an oversized write will fit
+	if(len > m_ringSize)
+	{
+		buf += len - m_ringSize;
+		len = m_ringSize;
+	}
+
+	InterruptGuard guard;
+
+	m_header->m_sealed = 0;
+
+	//Copy in up to two pieces, if we wrap
+	uint32_t start = m_offset;
+	uint32_t first = m_ringSize - start;
+	if(first > len)
+		first = len;
+	memcpy(m_ring + start, buf, first);
+	memcpy(m_ring, buf + first, len - first);
+
+	m_offset += len;
+	if(m_offset >= m_ringSize)
+		m_offset -= m_ringSize;
+	m_length += len;
+	if(m_length > m_ringSize)
+		m_length = m_ringSize;
+
+	m_header->m_offset = m_offset;
+	m_header->m_length = m_length;
+	m_header->m_check = ~(m_offset ^ m_length);
+
+	//Push the new data out to RAM now, so it survives a reset that never gets to Seal()
+	#ifdef HAVE_L1
+		CleanDataCache(m_ring + start, first);
+		if(len > first)
+			CleanDataCache(m_ring, len - first);
+		CleanDataCache(const_cast<RetainedLogHeader*>(m_header), sizeof(RetainedLogHeader));
+	#endif
+}
+
+void RetainedLogDevice::PrintBinary(char ch)
+{
+	Write(&ch, 1);
+}
+
+void RetainedLogDevice::PrintString(const char* str)
+{
+	Write(str, strlen(str));
+}
+
+///@brief Not supported, this is an output-only device
+char RetainedLogDevice::BlockingRead()
+{
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Inspection (typically done by the bootloader after a reset)
+
+/**
+	@brief Checks whether a region contains a retained log, and whether it's intact
+
+	@param base		Start of the region
+	@param size		Size of the region, including the header
+ */
+RetainedLogStatus RetainedLogDevice::Check(const void* base, uint32_t size)
+{
+	auto header = reinterpret_cast<const volatile RetainedLogHeader*>(base);
+
+	if( (size <= sizeof(RetainedLogHeader)) || (header->m_magic != RETAINED_LOG_MAGIC) )
+		return RETAINED_LOG_EMPTY;
+
+	uint32_t ringSize = header->m_ringSize;
+	uint32_t offset = header->m_offset;
+	uint32_t length = header->m_length;
+	if( (ringSize != size - sizeof(RetainedLogHeader)) ||
+		(offset >= ringSize) ||
+		(length > ringSize) ||
+		(header->m_check != ~(offset ^ length)) )
+	{
+		return RETAINED_LOG_EMPTY;
+	}
+
+	if(header->m_sealed != RETAINED_LOG_SEALED)
+		return RETAINED_LOG_UNSEALED;
+
+	auto ring = reinterpret_cast<const uint8_t*>(base) + sizeof(RetainedLogHeader);
+	if(CRC32(ring, ringSize) != header->m_crc)
+		return RETAINED_LOG_BAD_CRC;
+	return RETAINED_LOG_VALID;
+}
+
+///@brief Returns the number of bytes of log content in a region that passed Check()
+uint32_t RetainedLogDevice::GetLength(const void* base)
+{
+	return reinterpret_cast<const volatile RetainedLogHeader*>(base)->m_length;
+}
+
+/**
+	@brief Reads log content from a region that passed Check(), oldest first
+
+	@param base		Start of the region
+	@param offset	Position to start reading at, counted from the oldest retained byte
+	@param buf		Output buffer
+	@param len		Maximum number of bytes to read
+
+	@return Number of bytes read
+ */
+uint32_t RetainedLogDevice::Read(const void* base, uint32_t offset, char* buf, uint32_t len)
+{
+	auto header = reinterpret_cast<const volatile RetainedLogHeader*>(base);
+	auto ring = reinterpret_cast<const char*>(base) + sizeof(RetainedLogHeader);
+	uint32_t ringSize = header->m_ringSize;
+	uint32_t length = header->m_length;
+
+	if(offset >= length)
+		return 0;
+	if(len > length - offset)
+		len = length - offset;
+
+	//Oldest byte is right after the newest one, unless we never wrapped
+	uint32_t start = header->m_offset + ringSize - length + offset;
+	for(uint32_t i=0; i<len; i++)
+	{
+		uint32_t pos = start + i;
+		if(pos >= ringSize)
+			pos -= ringSize;
+		buf[i] = ring[pos];
+	}
+	return len;
+}
+
+/**
+	@brief Bitwise CRC-32 (IEEE 802.3), so sealing works without the CRC peripheral being enabled
+ */
+uint32_t RetainedLogDevice::CRC32(const uint8_t* data, uint32_t len)
+{
+	uint32_t crc = 0xffffffff;
+	for(uint32_t i=0; i<len; i++)
+	{
+		crc ^= data[i];
+		for(int j=0; j<8; j++)
+			crc = (crc >> 1) ^ (0xedb88320 & -(crc & 1));
+	}
+	return ~crc;
+}
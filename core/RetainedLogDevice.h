@@ -0,0 +1,143 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef RetainedLogDevice_h
+#define RetainedLogDevice_h
+
+#include <embedded-utils/CharacterDevice.h>
+#include <bootloader/BootloaderAPI.h>
+
+/**
+	@file
+	@brief Log sink which keeps the most recent log output in memory that survives a reset
+
+	The application adds a RetainedLogDevice to g_logSink; after a crash, the bootloader finds the log at the same
+	address and prints it. Writes are a memcpy plus a few header stores, cheap enough to leave on in production.
+
+	Define RETAINED_LOG_BASE (and optionally RETAINED_LOG_SIZE) identically in the bootloader and the application to
+	enable it. The region must not be touched by either startup code (e.g. STM32H7 backup SRAM at 0x38800000, or a
+	NOLOAD section). Each write is cleaned from the D-cache as it's made, so the region may be cacheable.
+
+	Reset() seals the log. The weak Cortex-M fault handlers in core/main.cpp call RetainedLog_OnFault(), which marks
+	the crash in g_bbram (STATE_CRASH, so the bootloader dumps the log) and resets. Applications with fault handlers
+	of their own should call RetainedLog_OnFault() from them.
+
+	Only the application writes the region. The bootloader just reads it, with Check() and Read().
+ */
+
+///@brief Size of the retained log region, including the header
+#ifndef RETAINED_LOG_SIZE
+#define RETAINED_LOG_SIZE 4096
+#endif
+
+#define RETAINED_LOG_MAGIC	0x474c4f52	//"RLOG"
+#define RETAINED_LOG_SEALED	0x4c414553	//"SEAL"
+
+///@brief Header at the start of the retained region
+struct RetainedLogHeader
+{
+	///@brief RETAINED_LOG_MAGIC if the region has been initialized
+	uint32_t m_magic;
+
+	///@brief Size of the data ring following the header
+	uint32_t m_ringSize;
+
+	///@brief Position in the ring the next byte will be written to
+	uint32_t m_offset;
+
+	///@brief Number of valid bytes in the ring (stops growing once it reaches m_ringSize)
+	uint32_t m_length;
+
+	///@brief ~(m_offset ^ m_length), to catch a header update torn by a reset
+	uint32_t m_check;
+
+	///@brief RETAINED_LOG_SEALED if m_crc is valid, i.e. nothing has been written since Seal() was called
+	uint32_t m_sealed;
+
+	///@brief CRC-32 of the ring contents, set by Seal()
+	uint32_t m_crc;
+};
+
+///@brief State of a retained log, as seen after a reset
+enum RetainedLogStatus
+{
+	RETAINED_LOG_EMPTY,			//no log (or header damaged beyond use)
+	RETAINED_LOG_UNSEALED,		//log present, but the app didn't get to seal it so it can't be verified
+	RETAINED_LOG_VALID,			//log present and CRC matches
+	RETAINED_LOG_BAD_CRC		//log was sealed, but contents changed since
+};
+
+class RetainedLogDevice : public CharacterDevice
+{
+public:
+	RetainedLogDevice(void* base, uint32_t size);
+
+	void Initialize();
+	void Clear();
+	void Seal();
+
+	void Write(const char* buf, uint32_t len);
+
+	virtual void PrintBinary(char ch) override;
+	virtual void PrintString(const char* str) override;
+	virtual char BlockingRead() override;
+
+	static RetainedLogStatus Check(const void* base, uint32_t size);
+	static uint32_t GetLength(const void* base);
+	static uint32_t Read(const void* base, uint32_t offset, char* buf, uint32_t len);
+	static uint32_t CRC32(const uint8_t* data, uint32_t len);
+
+protected:
+
+	///@brief Header at the start of the region
+	volatile RetainedLogHeader* m_header;
+
+	///@brief Data ring following the header
+	char* m_ring;
+
+	///@brief Size of m_ring
+	uint32_t m_ringSize;
+
+	///@brief Next write position within m_ring
+	uint32_t m_offset;
+
+	///@brief Number of valid bytes in m_ring
+	uint32_t m_length;
+
+	///@brief True once Initialize() has been called, i.e. the region is powered up and this firmware owns the log
+	bool m_active;
+};
+
+#ifdef RETAINED_LOG_BASE
+extern RetainedLogDevice g_retainedLog;
+
+void __attribute__((noreturn)) RetainedLog_OnFault(CrashReason reason);
+#endif
+
+#endif
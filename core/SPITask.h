@@ -35,12 +35,16 @@
 
 /**
 	@brief A task that handles SPI requests
+
+	Polled by default. If the application's SPI interrupt handler calls Wake() whenever it queues an event, construct
+	with alwaysReady = false and the task only runs while there are events to process.
  */
 template<size_t rxsize, size_t txsize> class SPITask : public Task
 {
 public:
-	SPITask(SPI<rxsize, txsize>* spi)
-		: m_spi(spi)
+	SPITask(SPI<rxsize, txsize>* spi, bool alwaysReady = true)
+		: Task(alwaysReady)
+		, m_spi(spi)
 	{}
 
 	virtual void Iteration()
@@ -59,6 +63,10 @@ public:
 				OnDataByte(event.data);
 				m_nbyte ++;
 			}
+
+			//One event per pass, so come back for the rest
+			if(m_spi->HasEvents())
+				Wake();
 		}
 	}
 
@@ -30,13 +30,141 @@
 #ifndef Task_h
 #define Task_h
 
+#include "TaskProfiler.h"
+
+///@brief Scheduling class for a task
+enum TaskPriority
+{
+	PRIORITY_REALTIME,		//revisited between every other task that runs (packet path etc)
+	PRIORITY_NORMAL,		//run once per pass through the main loop
+	PRIORITY_BACKGROUND		//run round robin, a limited number per pass
+};
+
+#ifdef MULTICORE
+///@brief Which cores a task may run on
+enum TaskAffinity
+{
+	AFFINITY_PINNED,		//only runs on the core whose task list it was registered in (default)
+	AFFINITY_ANY			//may be stolen by, and migrate to, any core
+};
+#endif
+
 /**
 	@brief A cooperative-multitasking operation to be executed as part of the main loop
+
+	By default a task is always ready, and Iteration() is called on every pass through the main loop.
+
+	Event-driven tasks can instead be constructed with alwaysReady = false. They are then only run after Wake() has
+	been called (from an ISR, another task, or another core), and cost nothing while idle.
+
+	In MULTICORE builds, tasks stay on the core they were registered on unless they opt in to migration with
+	SetAffinity(AFFINITY_ANY). Only do that for tasks which don't touch core-local peripherals or interrupts.
  */
 class Task
 {
 public:
+	Task(bool alwaysReady = true, TaskPriority priority = PRIORITY_NORMAL)
+		: m_alwaysReady(alwaysReady)
+		, m_priority(priority)
+		, m_wakePending(false)
+		#ifdef MULTICORE
+		, m_affinity(AFFINITY_PINNED)
+		#endif
+	{}
+
 	virtual void Iteration() =0;
+
+	/**
+		@brief Requests that the task be run on the next pass through the main loop
+
+		Safe to call from interrupt context or from another core.
+	 */
+	void Wake()
+	{
+		m_wakePending = true;
+
+		//Wake up the other core(s) in case they're sitting in WFE
+		#if defined(MULTICORE) && defined(__aarch64__)
+			asm volatile("dsb ish\n sev" ::: "memory");
+		#endif
+	}
+
+	///@brief Returns true if Wake() has been called since the last time the task ran
+	bool IsWakePending() const
+	{ return m_wakePending; }
+
+	///@brief Returns true if the task needs to be run
+	bool IsReady() const
+	{ return m_alwaysReady || m_wakePending; }
+
+	/**
+		@brief Checks if the task should be run, and clears any pending wakeup if so
+
+		The flag is cleared before the task runs, so a wakeup that arrives during Iteration() is not lost.
+	 */
+	bool ConsumeWakeup()
+	{
+		if(m_alwaysReady)
+			return true;
+		if(!m_wakePending)
+			return false;
+
+		m_wakePending = false;
+		return true;
+	}
+
+	///@brief Switches between polled and event-driven operation
+	void SetAlwaysReady(bool ready)
+	{ m_alwaysReady = ready; }
+
+	TaskPriority GetPriority() const
+	{ return m_priority; }
+
+	///@brief Changes the scheduling class (only takes effect when the scheduler is initialized)
+	void SetPriority(TaskPriority priority)
+	{ m_priority = priority; }
+
+	#ifdef MULTICORE
+	TaskAffinity GetAffinity() const
+	{ return m_affinity; }
+
+	///@brief Changes which cores the task may run on (only takes effect when the schedulers are initialized)
+	void SetAffinity(TaskAffinity affinity)
+	{ m_affinity = affinity; }
+	#endif
+
+	///@brief Runs the task, recording execution time if profiling is enabled
+	void Run()
+	{
+		#ifdef TASK_PROFILE
+			auto tstart = TaskProfiler::GetCycleCount();
+			Iteration();
+			m_profile.Record(TaskProfiler::GetCycleCount() - tstart);
+		#else
+			Iteration();
+		#endif
+	}
+
+	#ifdef TASK_PROFILE
+	///@brief Execution time statistics
+	TaskProfileData m_profile;
+	#endif
+
+protected:
+
+	///@brief True if the task should be polled every iteration regardless of wakeups
+	bool m_alwaysReady;
+
+	///@brief Scheduling class
+	TaskPriority m_priority;
+
+	///@brief True if Wake() has been called since the last time we ran
+	volatile bool m_wakePending;
+
+	#ifdef MULTICORE
+	///@brief Which cores we may run on
+	TaskAffinity m_affinity;
+	#endif
 };
 
 #endif
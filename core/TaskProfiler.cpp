@@ -0,0 +1,63 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include "platform.h"
+
+#ifdef TASK_PROFILE
+
+/**
+	@brief Turns on the cycle counter for the current core
+
+	Must be called on each core that dispatches tasks, since the counters are per core.
+ */
+void TaskProfiler::Initialize()
+{
+	#if defined(__aarch64__)
+
+		//Enable the cycle counter (PMCR.E and PMCNTENSET.C) and reset it (PMCR.C)
+		uint64_t pmcr;
+		asm volatile("mrs %0, pmcr_el0" : "=r"(pmcr));
+		pmcr |= 0x5;
+		asm volatile("msr pmcr_el0, %0" :: "r"(pmcr));
+		asm volatile("msr pmcntenset_el0, %0" :: "r"(1ULL << 31));
+		asm volatile("isb");
+
+	#elif !defined(__ARM_ARCH_6M__)
+
+		//Enable trace (DEMCR.TRCENA), then unlock the DWT (only needed on Cortex-M7, ignored elsewhere)
+		//and turn on CYCCNT
+		*reinterpret_cast<volatile uint32_t*>(0xe000edfc) |= (1 << 24);
+		*reinterpret_cast<volatile uint32_t*>(0xe0001fb0) = 0xc5acce55;
+		*reinterpret_cast<volatile uint32_t*>(0xe0001004) = 0;
+		*reinterpret_cast<volatile uint32_t*>(0xe0001000) |= 1;
+
+	#endif
+}
+
+#endif
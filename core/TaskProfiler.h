@@ -0,0 +1,123 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef TaskProfiler_h
+#define TaskProfiler_h
+
+/**
+	@file
+	@brief Per-task execution time accounting
+
+	Only compiled in when TASK_PROFILE is defined (set CEP_TASK_PROFILE in cmake). With it off, none of this code or
+	data exists and the main loop dispatch is unchanged.
+ */
+
+#ifdef TASK_PROFILE
+
+///@brief Number of latency histogram bins
+#define TASK_PROFILE_BINS 8
+
+/**
+	@brief Execution time statistics for a single task
+
+	Histogram bins are powers of 4 cycles, starting at 64: <64, <256, <1K, <4K, <16K, <64K, <256K, everything else
+ */
+class TaskProfileData
+{
+public:
+	TaskProfileData()
+	{ Reset(); }
+
+	void Reset()
+	{
+		m_calls = 0;
+		m_totalCycles = 0;
+		m_maxCycles = 0;
+		for(int i=0; i<TASK_PROFILE_BINS; i++)
+			m_histogram[i] = 0;
+	}
+
+	void Record(uint32_t cycles)
+	{
+		m_calls ++;
+		m_totalCycles += cycles;
+		if(cycles > m_maxCycles)
+			m_maxCycles = cycles;
+
+		uint32_t bin = 0;
+		uint32_t c = cycles >> 6;
+		while(c && (bin < (TASK_PROFILE_BINS - 1)) )
+		{
+			c >>= 2;
+			bin ++;
+		}
+		m_histogram[bin] ++;
+	}
+
+	///@brief Number of times the task was run
+	uint32_t m_calls;
+
+	///@brief Total cycles spent in the task
+	uint64_t m_totalCycles;
+
+	///@brief Longest single run of the task
+	uint32_t m_maxCycles;
+
+	///@brief Distribution of run times
+	uint32_t m_histogram[TASK_PROFILE_BINS];
+};
+
+/**
+	@brief Cycle counter access for the profiler
+
+	Uses PMCCNTR on aarch64 and DWT CYCCNT on Cortex-M. ARMv6-M parts (e.g. STM32L031) have no cycle counter, so
+	fall back to the log timer there; figures are then in 100us ticks rather than CPU cycles.
+ */
+class TaskProfiler
+{
+public:
+	static void Initialize();
+
+	static uint32_t GetCycleCount()
+	{
+		#if defined(__aarch64__)
+			uint64_t count;
+			asm volatile("mrs %0, pmccntr_el0" : "=r"(count));
+			return count;
+		#elif defined(__ARM_ARCH_6M__)
+			return g_logTimer.GetCount();
+		#else
+			return *reinterpret_cast<volatile uint32_t*>(0xe0001004);
+		#endif
+	}
+};
+
+#endif
+
+#endif
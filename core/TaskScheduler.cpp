@@ -0,0 +1,133 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include "platform.h"
+
+/**
+	@file
+	@brief Implementation of TaskScheduler
+ */
+
+/**
+	@brief Sorts a task list into priority classes
+
+	Registration order is preserved within each class. In MULTICORE builds, migratable tasks are skipped since they're
+	run by the WorkStealingQueue instead.
+ */
+void TaskScheduler::Initialize(etl::ivector<Task*>& tasks)
+{
+	m_realtime.clear();
+	m_normal.clear();
+	m_background.clear();
+	m_nextBackground = 0;
+
+	for(auto t : tasks)
+	{
+		#ifdef MULTICORE
+			if(t->GetAffinity() == AFFINITY_ANY)
+				continue;
+		#endif
+
+		switch(t->GetPriority())
+		{
+			case PRIORITY_REALTIME:
+				m_realtime.push_back(t);
+				break;
+
+			case PRIORITY_BACKGROUND:
+				m_background.push_back(t);
+				break;
+
+			case PRIORITY_NORMAL:
+			default:
+				m_normal.push_back(t);
+				break;
+		}
+	}
+}
+
+/**
+	@brief Runs all ready realtime tasks once
+
+	@return True if at least one task was run
+ */
+bool TaskScheduler::RunRealtime()
+{
+	bool ran = false;
+	for(auto t : m_realtime)
+	{
+		if(t->ConsumeWakeup())
+		{
+			t->Run();
+			ran = true;
+		}
+	}
+	return ran;
+}
+
+/**
+	@brief Does one pass through the task list
+
+	@return True if at least one task was run
+ */
+bool TaskScheduler::Dispatch()
+{
+	bool ran = RunRealtime();
+
+	for(auto t : m_normal)
+	{
+		if(t->ConsumeWakeup())
+		{
+			t->Run();
+			RunRealtime();
+			ran = true;
+		}
+	}
+
+	//Look at each background task at most once, stopping when we've used up the budget
+	uint32_t n = m_background.size();
+	uint32_t budget = m_backgroundBudget;
+	for(uint32_t i=0; (i < n) && budget; i++)
+	{
+		auto t = m_background[m_nextBackground];
+		m_nextBackground ++;
+		if(m_nextBackground >= n)
+			m_nextBackground = 0;
+
+		if(t->ConsumeWakeup())
+		{
+			t->Run();
+			RunRealtime();
+			ran = true;
+			budget --;
+		}
+	}
+
+	return ran;
+}
@@ -0,0 +1,83 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef TaskScheduler_h
+#define TaskScheduler_h
+
+#include "Task.h"
+
+#ifndef TASK_BACKGROUND_BUDGET
+#define TASK_BACKGROUND_BUDGET 1
+#endif
+
+/**
+	@brief Priority-aware dispatcher for a list of tasks
+
+	Each pass through the main loop:
+	* Realtime tasks are run first, and again after every normal or background task that actually did something
+	* Normal tasks are each run once
+	* Background tasks are run round robin, at most m_backgroundBudget of them per pass, so adding more housekeeping
+	  work doesn't stretch out the time between realtime visits
+ */
+class TaskScheduler
+{
+public:
+	TaskScheduler()
+		: m_nextBackground(0)
+		, m_backgroundBudget(TASK_BACKGROUND_BUDGET)
+	{}
+
+	void Initialize(etl::ivector<Task*>& tasks);
+
+	bool Dispatch();
+
+	///@brief Sets the number of background tasks that may run per pass (must be at least 1 to avoid starvation)
+	void SetBackgroundBudget(uint32_t budget)
+	{ m_backgroundBudget = budget ? budget : 1; }
+
+protected:
+	bool RunRealtime();
+
+	///@brief Realtime tasks
+	etl::vector<Task*, MAX_TASKS> m_realtime;
+
+	///@brief Normal tasks
+	etl::vector<Task*, MAX_TASKS> m_normal;
+
+	///@brief Background tasks
+	etl::vector<Task*, MAX_TASKS> m_background;
+
+	///@brief Index of the next background task to consider
+	uint32_t m_nextBackground;
+
+	///@brief Max number of background tasks to run per pass
+	uint32_t m_backgroundBudget;
+};
+
+#endif
@@ -0,0 +1,69 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include "platform.h"
+
+/**
+	@file
+	@brief Implementation of Timebase
+ */
+
+/**
+	@brief Rebases the log timer if it's getting close to wrapping, and folds the removed time into the base
+
+	Must be called regularly (at least once per rebaseThreshold ticks) from the main loop.
+
+	@param rebaseThreshold	Log timer value at which to rebase
+
+	@return True if a rebase happened
+ */
+bool Timebase::Update(uint32_t rebaseThreshold)
+{
+	//Fast path: nothing to do (only we ever restart the timer, so this can't change under us)
+	if(g_logTimer.GetCount() < rebaseThreshold)
+		return false;
+
+	//Mask interrupts so nothing on this core can observe the timer restarted but the base not yet updated
+	InterruptGuard guard;
+
+	m_sequence = m_sequence + 1;
+	Barrier();
+
+	//Logger restarts the timer from zero, so the time removed is whatever the count was just before
+	//(up to one tick can be lost between reading the count and the restart, same as the logger's own offset)
+	uint32_t count = g_logTimer.GetCount();
+	bool rebased = g_log.UpdateOffset(rebaseThreshold);
+	if(rebased)
+		m_base = m_base + count;
+
+	Barrier();
+	m_sequence = m_sequence + 1;
+
+	return rebased;
+}
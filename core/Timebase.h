@@ -0,0 +1,97 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef Timebase_h
+#define Timebase_h
+
+///@brief Log timer count at which the main loop rebases it (must be below the wrap point of a 16-bit timer)
+#ifndef TIMEBASE_REBASE_THRESHOLD
+#define TIMEBASE_REBASE_THRESHOLD 60000
+#endif
+
+/**
+	@brief 64-bit monotonic time, in log timer ticks (100us), built on top of the periodically rebased log timer
+
+	The hardware log timer is only 16 or 32 bits and gets restarted by Logger::UpdateOffset() every few seconds to keep
+	it from wrapping. Timebase tracks the total amount of time removed by each rebase, so base + current count gives a
+	timestamp that never goes backwards and won't wrap for the lifetime of the device.
+
+	Only one core (the one running the main loop timer tasks) may call Update(). GetTicks() is safe to call from any
+	core and from interrupt handlers.
+ */
+class Timebase
+{
+public:
+	constexpr Timebase()
+		: m_base(0)
+		, m_sequence(0)
+	{}
+
+	bool Update(uint32_t rebaseThreshold);
+
+	/**
+		@brief Get the current time in log timer ticks
+	 */
+	uint64_t GetTicks()
+	{
+		//Seqlock: m_sequence is odd while a rebase is in progress.
+		//The writer has interrupts masked for the duration, so spinning here can't deadlock against it.
+		while(true)
+		{
+			uint32_t seq = m_sequence;
+			Barrier();
+			uint64_t ticks = m_base + g_logTimer.GetCount();
+			Barrier();
+
+			if( ((seq & 1) == 0) && (seq == m_sequence) )
+				return ticks;
+		}
+	}
+
+protected:
+
+	static void Barrier()
+	{
+		#if defined(IPC_HOST_SIMULATION)
+			__atomic_signal_fence(__ATOMIC_SEQ_CST);
+		#elif defined(__aarch64__)
+			asm volatile("dmb ish" ::: "memory");
+		#else
+			asm volatile("dmb" ::: "memory");
+		#endif
+	}
+
+	///@brief Total number of ticks removed from the log timer by previous rebases
+	volatile uint64_t m_base;
+
+	///@brief Incremented before and after each rebase
+	volatile uint32_t m_sequence;
+};
+
+#endif
@@ -0,0 +1,179 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include "platform.h"
+
+/**
+	@file
+	@brief Implementation of TimerQueue
+ */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Queue management
+
+/**
+	@brief Loads a set of timer tasks into the queue
+
+	Any timer tasks found in the general task list are removed from it, since the queue now takes care of running them
+	and there's no point in polling them every iteration.
+ */
+void TimerQueue::Initialize(etl::ivector<TimerTask*>& timers, etl::ivector<Task*>& tasks)
+{
+	for(auto t : timers)
+	{
+		Add(t);
+
+		for(size_t i=0; i<tasks.size(); i++)
+		{
+			if(tasks[i] == t)
+			{
+				tasks.erase(tasks.begin() + i);
+				break;
+			}
+		}
+	}
+}
+
+/**
+	@brief Adds a new timer task to the queue
+ */
+void TimerQueue::Add(TimerTask* task)
+{
+	if(m_heap.full())
+		return;
+
+	task->m_queue = this;
+	task->m_queueIndex = m_heap.size();
+	m_heap.push_back(task);
+	SiftUp(task->m_queueIndex);
+}
+
+/**
+	@brief Restores heap ordering after a task's deadline has changed
+ */
+void TimerQueue::Reschedule(TimerTask* task)
+{
+	SiftUp(task->m_queueIndex);
+	SiftDown(task->m_queueIndex);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dispatch
+
+/**
+	@brief Runs every timer task whose deadline has passed
+
+	Each task fires at most once per call. A timer that is still due after firing (zero period, or catching up on
+	missed periods) ends the call, with it and anything behind it left for the next one, so a zero-period timer can't
+	starve the rest of the main loop.
+
+	@return True if at least one task was run
+ */
+bool TimerQueue::RunDueTasks(uint64_t now)
+{
+	bool ran = false;
+	for(size_t n=0; n<m_heap.size(); n++)
+	{
+		auto t = m_heap[0];
+
+		#ifdef TASK_PROFILE
+			auto tstart = TaskProfiler::GetCycleCount();
+			if(!t->Poll(now))
+				break;
+			t->m_profile.Record(TaskProfiler::GetCycleCount() - tstart);
+		#else
+			if(!t->Poll(now))
+				break;
+		#endif
+
+		//OnTimer() may have restarted other timers, so look up our position again rather than assuming we're the root
+		Reschedule(t);
+		ran = true;
+
+		//Still due, so it would be the root (or tied with it) again
+		if(t->m_target <= now)
+			break;
+	}
+
+	return ran;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Heap helpers
+
+void TimerQueue::Swap(uint32_t a, uint32_t b)
+{
+	auto ta = m_heap[a];
+	auto tb = m_heap[b];
+	m_heap[a] = tb;
+	m_heap[b] = ta;
+	tb->m_queueIndex = a;
+	ta->m_queueIndex = b;
+}
+
+void TimerQueue::SiftUp(uint32_t i)
+{
+	while(i > 0)
+	{
+		uint32_t parent = (i - 1) / 2;
+		if(m_heap[parent]->m_target <= m_heap[i]->m_target)
+			break;
+
+		Swap(parent, i);
+		i = parent;
+	}
+}
+
+/**
+	@brief Moves a task down the heap until no child has an earlier deadline
+
+	Ties sink too, so a task that just fired goes behind any others due at the same time instead of staying at the
+	root (otherwise a zero-period timer could keep the root for as long as the timebase doesn't move).
+ */
+void TimerQueue::SiftDown(uint32_t i)
+{
+	uint32_t len = m_heap.size();
+	while(true)
+	{
+		uint32_t left = 2*i + 1;
+		uint32_t right = left + 1;
+		if(left >= len)
+			break;
+
+		uint32_t child = left;
+		if( (right < len) && (m_heap[right]->m_target < m_heap[left]->m_target) )
+			child = right;
+
+		if(m_heap[child]->m_target > m_heap[i]->m_target)
+			break;
+
+		Swap(i, child);
+		i = child;
+	}
+}
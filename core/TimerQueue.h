@@ -0,0 +1,78 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef TimerQueue_h
+#define TimerQueue_h
+
+#include "TimerTask.h"
+
+/**
+	@brief Deadline-ordered scheduler for timer tasks
+
+	Timer tasks are kept in a binary min-heap keyed on their next deadline, so each pass through the main loop only
+	has to look at the head of the heap to find out if anything is due. Tasks which are not due are never touched.
+
+	In MULTICORE builds each core has its own queue. A queue, and the timers in it, must only be touched by the core
+	that owns it (including calls to TimerTask::Restart()).
+ */
+class TimerQueue
+{
+public:
+	TimerQueue()
+	{}
+
+	void Initialize(etl::ivector<TimerTask*>& timers, etl::ivector<Task*>& tasks);
+
+	void Add(TimerTask* task);
+	void Reschedule(TimerTask* task);
+
+	bool RunDueTasks(uint64_t now);
+
+	///@brief Returns true if there are no timers in the queue
+	bool empty() const
+	{ return m_heap.empty(); }
+
+	///@brief Returns the number of timers in the queue
+	size_t size() const
+	{ return m_heap.size(); }
+
+	///@brief Get the timestamp of the earliest deadline in the queue (only valid if not empty)
+	uint64_t GetNextDeadline() const
+	{ return m_heap[0]->m_target; }
+
+protected:
+	void SiftUp(uint32_t i);
+	void SiftDown(uint32_t i);
+	void Swap(uint32_t a, uint32_t b);
+
+	///@brief The timer tasks, stored as a binary min-heap on m_target
+	etl::vector<TimerTask*, MAX_TIMER_TASKS> m_heap;
+};
+
+#endif
@@ -31,10 +31,48 @@
 
 void TimerTask::Iteration()
 {
-	auto now = g_logTimer.GetCount();
-	if(now >= m_target)
+	Poll(g_timebase.GetTicks());
+}
+
+/**
+	@brief Picks the next deadline after the timer has fired
+
+	@param now	Timestamp the timer was fired at
+ */
+void TimerTask::UpdateTarget(uint64_t now)
+{
+	//Fixed rate modes make no sense with a zero period
+	if( (m_mode == TIMER_DELAY) || (m_period == 0) )
 	{
-		OnTimer();
+		if(m_period && ( (now - m_target) >= m_period) )
+			m_overruns ++;
 		m_target = now + m_period;
+		return;
+	}
+
+	m_target += m_period;
+	if(now < m_target)
+		return;
+
+	//We're at least a full period behind.
+	//In catch-up mode, run the missed periods back to back, unless we've fallen so far behind (e.g. a long blocking
+	//operation during boot) that it's better to drop them
+	uint64_t behind = now - m_target;
+	if( (m_mode == TIMER_FIXED_RATE_CATCHUP) && (behind < static_cast<uint64_t>(TIMER_MAX_CATCHUP) * m_period) )
+		m_overruns ++;
+	else
+	{
+		uint64_t missed = behind / m_period + 1;
+		m_overruns += missed;
+		m_target += missed * m_period;
 	}
 }
+
+void TimerTask::Restart()
+{
+	m_target = g_timebase.GetTicks() + m_period;
+
+	//Deadline moved, so our position in the queue may have changed too
+	if(m_queue)
+		m_queue->Reschedule(this);
+}
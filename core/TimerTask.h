@@ -32,37 +32,103 @@
 
 #include "Task.h"
 
+class TimerQueue;
+
+///@brief Max number of missed periods a catch-up timer will try to make up before dropping them
+#ifndef TIMER_MAX_CATCHUP
+#define TIMER_MAX_CATCHUP 10
+#endif
+
+///@brief How a timer task picks its next deadline after firing
+enum TimerMode
+{
+	///@brief Next deadline is one period after the timer actually ran (lateness accumulates)
+	TIMER_DELAY,
+
+	///@brief Next deadline is one period after the previous deadline, missed periods are run back to back
+	///(up to TIMER_MAX_CATCHUP)
+	TIMER_FIXED_RATE_CATCHUP,
+
+	///@brief Next deadline is the next whole period after the previous deadline, missed periods are dropped
+	TIMER_FIXED_RATE_SKIP
+};
+
 /**
 	@brief A task that executes a function at regular intervals
  */
 class TimerTask : public Task
 {
 public:
-	TimerTask(uint32_t initialOffset, uint32_t period)
-		: m_target(g_logTimer.GetCount() + initialOffset)
+	TimerTask(uint32_t initialOffset, uint32_t period, TimerMode mode = TIMER_DELAY)
+		: m_target(g_timebase.GetTicks() + initialOffset)
 		, m_period(period)
+		, m_mode(mode)
+		, m_overruns(0)
+		, m_queue(nullptr)
+		, m_queueIndex(0)
 	{}
 
-	void OnTimerShift(uint32_t delta)
+	virtual void Iteration();
+
+	//Start the timer to begin now
+	void Restart();
+
+	///@brief Get the timestamp (on g_timebase) of the next execution
+	uint64_t GetTarget() const
+	{ return m_target; }
+
+	/**
+		@brief Runs the timer callback if the deadline has passed
+
+		@return True if the timer fired
+	 */
+	bool Poll(uint64_t now)
 	{
-		if(m_target > delta)
-			m_target -= delta;
+		if(now < m_target)
+			return false;
+
+		OnTimer();
+		UpdateTarget(now);
+		return true;
 	}
 
-	virtual void Iteration();
+	///@brief Get the number of periods that were missed or run at least a full period late
+	uint32_t GetOverruns() const
+	{ return m_overruns; }
 
-	//Start the timer to begin now
-	void Restart()
-	{ m_target = g_logTimer.GetCount() + m_period; }
+	void ClearOverruns()
+	{ m_overruns = 0; }
+
+	uint32_t GetPeriod() const
+	{ return m_period; }
+
+	TimerMode GetMode() const
+	{ return m_mode; }
 
 protected:
+	void UpdateTarget(uint64_t now);
+
 	virtual void OnTimer() =0;
 
-	///@brief Timestamp of the next execution
-	uint32_t m_target;
+	friend class TimerQueue;
+
+	///@brief Timestamp (on g_timebase) of the next execution
+	uint64_t m_target;
 
 	///@brief Number of timer ticks between executions
 	uint32_t m_period;
+
+	///@brief Deadline update policy
+	TimerMode m_mode;
+
+	///@brief Number of missed or late periods
+	uint32_t m_overruns;
+
+	///@brief The queue we're scheduled in (if any)
+	TimerQueue* m_queue;
+
+	///@brief Our position within the queue's heap
+	uint32_t m_queueIndex;
 };
 
 #endif
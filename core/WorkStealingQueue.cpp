@@ -0,0 +1,181 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include "platform.h"
+
+#ifdef MULTICORE
+
+/**
+	@file
+	@brief Implementation of WorkStealingQueue
+ */
+
+///@brief Number of migratable tasks handed out so far, across all cores
+static uint32_t g_migratableTaskCount = 0;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setup
+
+/**
+	@brief Loads the migratable tasks from a core's task list into its queue
+
+	Must be called on the owning core before it starts dispatching. Tasks stay in the task list (so they still show up
+	in the task profile etc), but TaskScheduler ignores them.
+
+	If the queues are full the task is pinned to this core instead.
+ */
+void WorkStealingQueue::Initialize(etl::ivector<Task*>& tasks)
+{
+	for(auto t : tasks)
+	{
+		if(t->GetAffinity() != AFFINITY_ANY)
+			continue;
+
+		//Make sure every migratable task in the system fits in a single queue, so Push() after a steal can't fail
+		if(__atomic_fetch_add(&g_migratableTaskCount, 1, __ATOMIC_RELAXED) >= WORK_QUEUE_SIZE)
+		{
+			//Logger has no 64-bit conversions, but the low half of the address is enough to tell tasks apart
+			g_log(Logger::WARNING, "Out of work queue slots, pinning task %08x\n",
+				static_cast<uint32_t>(reinterpret_cast<uintptr_t>(t)));
+			t->SetAffinity(AFFINITY_PINNED);
+			continue;
+		}
+
+		Push(t);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Queue operations
+
+/**
+	@brief Adds a task to the bottom of the queue (owner only)
+
+	@return False if the queue was full
+ */
+bool WorkStealingQueue::Push(Task* task)
+{
+	uint32_t b = __atomic_load_n(&m_bottom, __ATOMIC_RELAXED);
+	uint32_t t = __atomic_load_n(&m_top, __ATOMIC_ACQUIRE);
+	if( (b - t) >= WORK_QUEUE_SIZE)
+		return false;
+
+	__atomic_store_n(&m_tasks[b & (WORK_QUEUE_SIZE - 1)], task, __ATOMIC_RELAXED);
+
+	//Task pointer has to be visible before the new bottom is
+	__atomic_store_n(&m_bottom, b + 1, __ATOMIC_RELEASE);
+	return true;
+}
+
+/**
+	@brief Takes the task at the top of the queue (any core)
+
+	@return The task, or null if the queue was empty or another core beat us to it
+ */
+Task* WorkStealingQueue::Steal()
+{
+	uint32_t t = __atomic_load_n(&m_top, __ATOMIC_ACQUIRE);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	uint32_t b = __atomic_load_n(&m_bottom, __ATOMIC_ACQUIRE);
+
+	if(static_cast<int32_t>(b - t) <= 0)
+		return nullptr;
+
+	//Read the slot before claiming it: once top moves past it the owner is free to reuse the slot
+	auto task = __atomic_load_n(&m_tasks[t & (WORK_QUEUE_SIZE - 1)], __ATOMIC_RELAXED);
+	if(!__atomic_compare_exchange_n(&m_top, &t, t + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+		return nullptr;
+
+	return task;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dispatch
+
+/**
+	@brief Runs the migratable tasks currently queued on this core, then steals one from the busiest other core if it
+	has noticeably more than we do
+
+	Each task is run (if ready) and then pushed back onto our own queue, so stolen tasks stay with us.
+
+	@param core	Index of the calling core, which must own this queue
+
+	@return True if at least one task was run
+ */
+bool WorkStealingQueue::Dispatch(unsigned int core)
+{
+	bool ran = false;
+
+	//Round robin through everything we had at the start of the pass.
+	//Anything we push back goes in behind it, so each task is looked at no more than once.
+	uint32_t n = size();
+	for(uint32_t i=0; i<n; i++)
+	{
+		auto t = Steal();
+		if(!t)
+			break;
+
+		if(t->ConsumeWakeup())
+		{
+			t->Run();
+			ran = true;
+		}
+		Push(t);
+	}
+
+	//If another core has at least two more tasks queued than we do, take one to even out the load
+	unsigned int victim = core;
+	uint32_t victimSize = n + 1;
+	for(unsigned int i=0; i<NUM_SECONDARY_CORES; i++)
+	{
+		uint32_t len = g_workQueues[i].size();
+		if(len > victimSize)
+		{
+			victim = i;
+			victimSize = len;
+		}
+	}
+	if(victim != core)
+	{
+		auto t = g_workQueues[victim].Steal();
+		if(t)
+		{
+			if(t->ConsumeWakeup())
+			{
+				t->Run();
+				ran = true;
+			}
+			Push(t);
+		}
+	}
+
+	return ran;
+}
+
+#endif
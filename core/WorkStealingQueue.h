@@ -0,0 +1,96 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef WorkStealingQueue_h
+#define WorkStealingQueue_h
+
+#ifdef MULTICORE
+
+#include "Task.h"
+
+///@brief Max number of migratable tasks across all cores (must be a power of two)
+#ifndef WORK_QUEUE_SIZE
+#define WORK_QUEUE_SIZE 32
+#endif
+
+static_assert( (WORK_QUEUE_SIZE & (WORK_QUEUE_SIZE - 1)) == 0, "WORK_QUEUE_SIZE must be a power of two");
+
+/**
+	@brief Per-core queue of migratable tasks, which idle cores can steal from
+
+	This is the bounded variant of the Chase-Lev work-stealing deque. Only the owning core pushes, at the bottom; any
+	core (including the owner) takes from the top with a CAS on the top index.
+
+	The owner deliberately consumes from the top rather than popping from the bottom: every task taken off a queue is
+	run once and then pushed back onto the queue of the core that ran it, so taking from the top gives round robin
+	order instead of running the most recently pushed task over and over.
+
+	A task is in exactly one queue unless it's being run, so it can never run on two cores at once. A task taken from
+	another core's queue ends up in the thief's queue afterwards, which is how work migrates.
+ */
+class WorkStealingQueue
+{
+public:
+	constexpr WorkStealingQueue()
+		: m_top(0)
+		, m_bottom(0)
+		, m_tasks{}
+	{}
+
+	void Initialize(etl::ivector<Task*>& tasks);
+
+	bool Dispatch(unsigned int core);
+
+	bool Push(Task* task);
+	Task* Steal();
+
+	///@brief Approximate number of tasks in the queue (may be stale if other cores are stealing)
+	uint32_t size() const
+	{
+		int32_t n = __atomic_load_n(&m_bottom, __ATOMIC_RELAXED) - __atomic_load_n(&m_top, __ATOMIC_RELAXED);
+		return (n > 0) ? n : 0;
+	}
+
+protected:
+
+	//Top and bottom are written by different cores, keep them in separate cache lines
+
+	///@brief Index of the oldest task, advanced by whoever takes it
+	alignas(64) uint32_t m_top;
+
+	///@brief Index one past the newest task, only written by the owner
+	alignas(64) uint32_t m_bottom;
+
+	///@brief Ring buffer of tasks
+	alignas(64) Task* m_tasks[WORK_QUEUE_SIZE];
+};
+
+#endif
+
+#endif
@@ -63,6 +63,18 @@ void __attribute__((noreturn)) BSP_MainLoop();
 ///@brief Run an iteration of the main loop
 void BSP_MainLoopIteration();
 
+/**
+	@brief Program a compare match on the log timer so the CPU wakes up from WFE at the given timestamp
+
+	Optional, used by the idle main loop mode. The default implementation returns false, which disables sleeping.
+
+	@return True if the wakeup was armed
+ */
+bool BSP_ArmWakeupTimer(uint32_t target);
+
+///@brief Clear the compare match set up by BSP_ArmWakeupTimer() after waking up
+void BSP_DisarmWakeupTimer();
+
 #ifdef __aarch64__
 extern "C" void BSP_InitPageTables();
 extern "C" void BSP_InitMMU();
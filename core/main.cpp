@@ -29,6 +29,10 @@
 
 #include "platform.h"
 
+#ifdef RETAINED_LOG_BASE
+#include "RetainedLogDevice.h"
+#endif
+
 /**
 	@file
 	@author		Andrew D. Zonenberg
@@ -44,6 +48,36 @@ KVS* g_kvs = nullptr;
 ///@brief Global log sink object
 LogSink<MAX_LOG_SINKS>* g_logSink = nullptr;
 
+
+///@brief 64-bit monotonic time built on g_logTimer
+Timebase g_timebase;
+
+#ifdef MULTICORE
+///@brief Schedulers for timer tasks on each core
+TimerQueue g_timerQueue[NUM_SECONDARY_CORES];
+
+///@brief Dispatchers for regular tasks on each core
+TaskScheduler g_taskScheduler[NUM_SECONDARY_CORES];
+
+///@brief Migratable tasks for each core
+WorkStealingQueue g_workQueues[NUM_SECONDARY_CORES];
+#else
+///@brief Scheduler for timer tasks
+TimerQueue g_timerQueue;
+
+///@brief Dispatcher for regular tasks
+TaskScheduler g_taskScheduler;
+#endif
+
+///@brief Behavior of the main loop when there's nothing to do
+MainLoopMode g_mainLoopMode = MAINLOOP_POLL;
+
+///@brief Upper bound on a single idle period (1 ms) so always-ready tasks still get polled
+uint32_t g_mainLoopMaxIdle = 10;
+
+///@brief Busy/idle time accounting
+MainLoopStats g_mainLoopStats = {0, 0, 0};
+
 //called by newlib on arm targets and MulticoreStartup.S on aarch64 targets
 extern "C" void hardware_init_hook();
 
@@ -124,29 +158,70 @@ void CoreInit(unsigned int core)
 	//For now, nothing on other cores
 }
 
+void __attribute__((weak)) RegisterMulticoreLogDrainTask()
+{
+}
+
+#ifdef __aarch64__
+/**
+	@brief Turns on the generic timer event stream so WFE wakes up at least once per log timer tick
+
+	Secondary cores have no log timer compare interrupt to wake them for timer deadlines, so instead we have the
+	generic timer send a periodic event, at the slowest rate that's still at least 10 kHz.
+ */
+static void EnableTimerEventStream()
+{
+	uint64_t freq;
+	asm volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+
+	//Event fires on every transition of counter bit EVNTI, i.e. every 2^(EVNTI+1) ticks
+	uint64_t ticksPerLogTick = freq / 10000;
+	uint64_t evnti = 0;
+	while( (evnti < 15) && ( (2ULL << (evnti + 1)) <= ticksPerLogTick) )
+		evnti ++;
+
+	uint64_t ctl;
+	asm volatile("mrs %0, cntkctl_el1" : "=r"(ctl));
+	ctl = (ctl & ~0xf0ULL) | (evnti << 4) | 0x4;
+	asm volatile("msr cntkctl_el1, %0" :: "r"(ctl));
+	asm volatile("isb");
+}
+#endif
+
 void CoreMain(unsigned int core)
 {
 	g_log("Total tasks: %d of %d slots\n", g_tasks[core].size(), g_tasks[core].capacity());
-	if(core == 0)
-		g_log("Timer tasks: %d of %d slots\n", g_timerTasks.size(), g_timerTasks.capacity());
+	g_log("Timer tasks: %d of %d slots\n", g_timerTasks[core].size(), g_timerTasks[core].capacity());
 	g_log("Ready\n");
 
-	//First core runs timer tasks and non-task stuff
+	#ifdef TASK_PROFILE
+		TaskProfiler::Initialize();
+	#endif
+
+	//Every core has its own timer tasks
+	g_timerQueue[core].Initialize(g_timerTasks[core], g_tasks[core]);
+
+	//First core maintains the timebase and runs non-task stuff
 	if(core == 0)
 	{
+		//Make sure log output from the other cores actually gets sent somewhere
+		RegisterMulticoreLogDrainTask();
+
+		g_taskScheduler[core].Initialize(g_tasks[core]);
+		g_workQueues[core].Initialize(g_tasks[core]);
+
 		while(1)
 		{
-			//Check for overflows on our timer
-			const int logTimerMax = 60000;
-			if(g_log.UpdateOffset(logTimerMax))
-			{
-				for(auto t : g_timerTasks)
-					t->OnTimerShift(logTimerMax);
-			}
+			//Rebase our timer before it overflows
+			const int logTimerMax = TIMEBASE_REBASE_THRESHOLD;
+			g_timebase.Update(logTimerMax);
+
+			//Run any timer tasks that are due
+			g_timerQueue[core].RunDueTasks(g_timebase.GetTicks());
 
 			//Run all of our regular tasks
-			for(auto t : g_tasks[core])
-				t->Iteration();
+			g_taskScheduler[core].Dispatch();
+			g_workQueues[core].Dispatch(core);
 
 			//Run any non-task stuff
 			BSP_MainLoopIteration();
@@ -156,11 +231,33 @@ void CoreMain(unsigned int core)
 	//Other core(s) just run tasks
 	else
 	{
+		g_taskScheduler[core].Initialize(g_tasks[core]);
+		g_workQueues[core].Initialize(g_tasks[core]);
+
+		//If we have timers we need to wake up to check them even if nobody sends us an event
+		bool canSleep = true;
+		if(!g_timerQueue[core].empty())
+		{
+			#ifdef __aarch64__
+				EnableTimerEventStream();
+			#else
+				canSleep = false;
+			#endif
+		}
+
 		while(1)
 		{
-			//Run all of our regular tasks
-			for(auto t : g_tasks[core])
-				t->Iteration();
+			//Run any timer tasks that are due (core 0 keeps the timebase up to date for us)
+			bool ran = g_timerQueue[core].RunDueTasks(g_timebase.GetTicks());
+
+			//Run all of our regular tasks, then sleep until woken if none of them had anything to do
+			//(Task::Wake() sends an event so we can't miss a wakeup between the check and the WFE)
+			if(g_taskScheduler[core].Dispatch())
+				ran = true;
+			if(g_workQueues[core].Dispatch(core))
+				ran = true;
+			if(!ran && canSleep)
+				asm volatile("wfe");
 		}
 	}
 }
@@ -203,6 +300,11 @@ int main()
 
 void __attribute__((noreturn)) Reset()
 {
+	//Let the bootloader verify the log leading up to the reset
+	#ifdef RETAINED_LOG_BASE
+		g_retainedLog.Seal();
+	#endif
+
 	SCB.AIRCR = 0x05fa0004;
 	while(1)
 	{}
@@ -216,28 +318,106 @@ void __attribute__((weak)) __attribute__((noreturn)) BSP_MainLoop()
 	DefaultMainLoop();
 }
 
+bool __attribute__((weak)) BSP_ArmWakeupTimer([[maybe_unused]] uint32_t target)
+{
+	return false;
+}
+
+void __attribute__((weak)) BSP_DisarmWakeupTimer()
+{
+}
+
+/**
+	@brief Sleeps until the next timer deadline, an interrupt, or the max idle period, whichever comes first
+
+	@param tstart		Log timer value at the start of this main loop iteration
+	@param logTimerMax	Value at which the log timer gets rebased, we must be awake for that
+ */
+static void IdleUntilNextDeadline(uint32_t tstart, uint32_t logTimerMax)
+{
+	auto now = g_logTimer.GetCount();
+	g_mainLoopStats.m_busyTicks += now - tstart;
+
+	//Don't sleep if an event-driven task was woken while we were running
+	for(auto t : g_tasks)
+	{
+		if(t->IsWakePending())
+			return;
+	}
+
+	//Figure out when we next need to be awake.
+	//Timer deadlines are on the monotonic timebase, convert to a log timer value for the compare hardware.
+	uint32_t sleepTicks = g_mainLoopMaxIdle;
+	if(!g_timerQueue.empty())
+	{
+		uint64_t tnow = g_timebase.GetTicks();
+		uint64_t next = g_timerQueue.GetNextDeadline();
+		if(next <= tnow)
+			return;
+		if( (next - tnow) < sleepTicks)
+			sleepTicks = next - tnow;
+	}
+	uint32_t deadline = now + sleepTicks;
+	if(deadline > logTimerMax)
+		deadline = logTimerMax;
+	if(deadline <= now)
+		return;
+
+	if(!BSP_ArmWakeupTimer(deadline))
+		return;
+
+	//If the timer got past the compare value before we armed it, the match will never fire
+	if(g_logTimer.GetCount() >= deadline)
+	{
+		BSP_DisarmWakeupTimer();
+		return;
+	}
+
+	//Sleep until an interrupt goes pending.
+	//Use WFE rather than WFI: an interrupt taken between the checks above and here sets the event register, so we
+	//can't miss a wakeup, and with SEVONPEND the timer match wakes us without needing an ISR.
+	asm volatile("dsb");
+	asm volatile("wfe");
+
+	BSP_DisarmWakeupTimer();
+
+	g_mainLoopStats.m_idleTicks += g_logTimer.GetCount() - now;
+	g_mainLoopStats.m_sleeps ++;
+}
+
 void __attribute__((noreturn)) DefaultMainLoop()
 {
 	g_log("Total tasks: %d of %d slots\n", g_tasks.size(), g_tasks.capacity());
 	g_log("Timer tasks: %d of %d slots\n", g_timerTasks.size(), g_timerTasks.capacity());
 	g_log("Ready\n");
 
+	#ifdef TASK_PROFILE
+		TaskProfiler::Initialize();
+	#endif
+
+	g_timerQueue.Initialize(g_timerTasks, g_tasks);
+	g_taskScheduler.Initialize(g_tasks);
+
 	while(1)
 	{
-		//Check for overflows on our timer
-		const int logTimerMax = 60000;
-		if(g_log.UpdateOffset(logTimerMax))
-		{
-			for(auto t : g_timerTasks)
-				t->OnTimerShift(logTimerMax);
-		}
+		//Rebase our timer before it overflows
+		const int logTimerMax = TIMEBASE_REBASE_THRESHOLD;
+		g_timebase.Update(logTimerMax);
+
+		auto tstart = g_logTimer.GetCount();
+
+		//Run any timer tasks that are due
+		g_timerQueue.RunDueTasks(g_timebase.GetTicks());
 
 		//Run all of our regular tasks
-		for(auto t : g_tasks)
-			t->Iteration();
+		g_taskScheduler.Dispatch();
 
 		//Run any non-task stuff
 		BSP_MainLoopIteration();
+
+		//Go to sleep if we're allowed to
+		if(g_mainLoopMode == MAINLOOP_IDLE)
+			IdleUntilNextDeadline(tstart, logTimerMax);
 	}
 }
 
@@ -250,11 +430,99 @@ void __attribute__((noreturn)) DefaultMainLoop()
 
 void __attribute__((noreturn)) Reset()
 {
+	//Let the bootloader verify the log leading up to the reset
+	#ifdef RETAINED_LOG_BASE
+		g_retainedLog.Seal();
+	#endif
+
 	SCB.AIRCR = 0x05fa0004;
 	while(1)
 	{}
 }
 
+#ifdef RETAINED_LOG_BASE
+
+#ifdef HAVE_RTC
+///@brief Bootloader state in the RTC backup registers (weak, since the bootloader defines its own)
+volatile BootloaderBBRAM* __attribute__((weak)) g_bbram = reinterpret_cast<volatile BootloaderBBRAM*>(&_RTC.BKP[0]);
+#endif
+
+/**
+	@brief Tells the bootloader we crashed, then resets so it can dump the retained log
+
+	Reset() seals the log first. Weak, so an application can record more state before resetting.
+ */
+void __attribute__((weak)) __attribute__((noreturn)) RetainedLog_OnFault(CrashReason reason)
+{
+	#ifdef HAVE_RTC
+		g_bbram->m_crashReason = reason;
+		g_bbram->m_state = STATE_CRASH;
+	#else
+		(void)reason;
+	#endif
+
+	Reset();
+}
+
+//Weak, so applications with fault handlers of their own keep them (and call RetainedLog_OnFault() from them)
+extern "C" void __attribute__((weak)) NMI_Handler()
+{
+	RetainedLog_OnFault(CRASH_NMI);
+}
+
+extern "C" void __attribute__((weak)) HardFault_Handler()
+{
+	RetainedLog_OnFault(CRASH_HARD_FAULT);
+}
+
+extern "C" void __attribute__((weak)) MemManage_Handler()
+{
+	RetainedLog_OnFault(CRASH_MMU_FAULT);
+}
+
+extern "C" void __attribute__((weak)) BusFault_Handler()
+{
+	RetainedLog_OnFault(CRASH_BUS_FAULT);
+}
+
+extern "C" void __attribute__((weak)) UsageFault_Handler()
+{
+	RetainedLog_OnFault(CRASH_USAGE_FAULT);
+}
+
+#endif
+
+/**
+	@brief Prepares an interrupt line to wake the CPU from WFE without actually taking the interrupt
+
+	The interrupt stays disabled in the NVIC, but with SEVONPEND set it becoming pending generates a wakeup event.
+ */
+void EnableWakeOnPendingIRQ(uint32_t irq)
+{
+	SCB.SCR |= 0x10;
+	ClearPendingIRQ(irq);
+}
+
+/**
+	@brief Clears the NVIC pending bit for an interrupt
+
+	SEVONPEND only fires on a transition to pending, so this has to be done after every wakeup.
+ */
+void ClearPendingIRQ(uint32_t irq)
+{
+	volatile uint32_t* icpr = reinterpret_cast<volatile uint32_t*>(0xe000e280);
+	icpr[irq / 32] = (1 << (irq % 32));
+}
+
+/**
+	@brief Enables an interrupt in the NVIC
+ */
+void EnableIRQ(uint32_t irq)
+{
+	volatile uint32_t* iser = reinterpret_cast<volatile uint32_t*>(0xe000e100);
+	iser[irq / 32] = (1 << (irq % 32));
+}
+
 #endif
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -284,6 +552,9 @@ void InitKVS(StorageBank* left, StorageBank* right, uint32_t logsize)
 	g_log("Active bank: %s (rev %d)\n",
 		kvs.IsLeftBankActive() ? "left" : "right",
 		kvs.GetBankHeaderVersion() );
+
+	//Apply saved log levels
+	LogCategory::LoadConfigFromKVS();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
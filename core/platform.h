@@ -55,6 +55,9 @@ void __attribute__((noreturn)) Reset();
 void InitKVS(StorageBank* left, StorageBank* right, uint32_t logsize);
 void FormatBuildID(const uint8_t* buildID, char* strOut);
 void PrintCortexMInfo();
+void EnableWakeOnPendingIRQ(uint32_t irq);
+void ClearPendingIRQ(uint32_t irq);
+void EnableIRQ(uint32_t irq);
 
 #ifdef __aarch64__
 void PrintCortexAInfo();
@@ -63,9 +66,35 @@ void PrintCortexAInfo();
 //Returns true in bootloader, false in application firmware
 bool IsBootloader();
 
+//Printf has no pointer or 64-bit conversions, so print pointers as one or two 32-bit halves
+#ifdef __aarch64__
+	#define PTR_FMT "%08x%08x"
+	#define PTR_ARGS(p) \
+		static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p) >> 32), \
+		static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p))
+#else
+	#define PTR_FMT "%08x"
+	#define PTR_ARGS(p) static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p))
+#endif
+
+#include "InterruptGuard.h"
+
+//Monotonic 64-bit time
+#include "Timebase.h"
+extern Timebase g_timebase;
+
 //Task types
 #include "Task.h"
 #include "TimerTask.h"
+#include "TimerQueue.h"
+#include "TaskScheduler.h"
+#include "WorkStealingQueue.h"
+
+//Binary logging with host-side formatting
+#include "DeferredLog.h"
+
+//Per-subsystem log levels
+#include "LogCategory.h"
 
 #include "bsp.h"
 
@@ -77,16 +106,35 @@ bool IsBootloader();
 	//All tasks
 	extern etl::vector<Task*, MAX_TASKS>  g_tasks[NUM_SECONDARY_CORES];
 
-	//Timer tasks (strict subset of total tasks), can only live on core 0 for now
-	extern etl::vector<TimerTask*, MAX_TIMER_TASKS>  g_timerTasks;
+	//Priority-aware dispatchers for each core's tasks
+	extern TaskScheduler g_taskScheduler[NUM_SECONDARY_CORES];
+
+	//Queues of migratable tasks for each core, which other cores can steal from when idle
+	extern WorkStealingQueue g_workQueues[NUM_SECONDARY_CORES];
+
+	//Timer tasks for each core (strict subset of that core's tasks).
+	//This used to be a single list, run by core 0. Applications that defined it as
+	//	etl::vector<TimerTask*, MAX_TIMER_TASKS> g_timerTasks;
+	//must now define one list per core, like g_tasks, and register their existing timers in g_timerTasks[0]:
+	//	etl::vector<TimerTask*, MAX_TIMER_TASKS> g_timerTasks[NUM_SECONDARY_CORES];
+	extern etl::vector<TimerTask*, MAX_TIMER_TASKS>  g_timerTasks[NUM_SECONDARY_CORES];
+
+	//Deadline-ordered queues that run each core's timer tasks
+	extern TimerQueue g_timerQueue[NUM_SECONDARY_CORES];
 
 //SINGLE CORE flow
 #else
 	//All tasks
 	extern etl::vector<Task*, MAX_TASKS>  g_tasks;
 
+	//Priority-aware dispatcher for the tasks
+	extern TaskScheduler g_taskScheduler;
+
 	//Timer tasks (strict subset of total tasks)
 	extern etl::vector<TimerTask*, MAX_TIMER_TASKS>  g_timerTasks;
+
+	//Deadline-ordered queue that runs the timer tasks
+	extern TimerQueue g_timerQueue;
 #endif
 
 //Helpers for FPGA interfacing
@@ -102,11 +150,35 @@ extern LogSink<MAX_LOG_SINKS>* g_logSink;
 
 void __attribute__((noreturn)) DefaultMainLoop();
 
+//Main loop behavior when there's nothing to do
+enum MainLoopMode
+{
+	MAINLOOP_POLL,		//spin continuously (default)
+	MAINLOOP_IDLE		//sleep until the next timer deadline or interrupt when no work is pending
+};
+extern MainLoopMode g_mainLoopMode;
+
+//Longest time, in log timer ticks, the idle loop may sleep before polling tasks again
+extern uint32_t g_mainLoopMaxIdle;
+
+//Time accounting for the idle main loop, in log timer ticks
+struct MainLoopStats
+{
+	uint64_t m_busyTicks;
+	uint64_t m_idleTicks;
+	uint32_t m_sleeps;
+};
+extern MainLoopStats g_mainLoopStats;
+
 //Callbacks for multicore init
 #ifdef MULTICORE
 extern "C" void hardware_init_hook();
 extern "C" void CoreInit(unsigned int core);
 extern "C" void CoreMain(unsigned int core);
+
+//Adds the MulticoreLogDevice drain task to core 0's task list, if there is a MulticoreLogDevice and the application
+//didn't register the task itself (weak no-op if MulticoreLogDevice isn't linked in)
+void RegisterMulticoreLogDrainTask();
 #endif
 
 #endif
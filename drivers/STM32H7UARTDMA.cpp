@@ -0,0 +1,218 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include "STM32H7UARTDMA.h"
+
+#ifdef STM32H7
+
+/**
+	@file
+	@brief Implementation of STM32H7UARTDMA
+
+	Register layouts are from RM0468 (STM32H72x/73x) and RM0433 (STM32H742/743/750), which agree for DMA1, DMAMUX1, and
+	the USART registers used here.
+ */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Register definitions
+
+///@brief One DMA stream
+struct h7dmastream_t
+{
+	uint32_t CR;
+	uint32_t NDTR;
+	uint32_t PAR;
+	uint32_t M0AR;
+	uint32_t M1AR;
+	uint32_t FCR;
+};
+
+///@brief DMA1 or DMA2
+struct h7dma_t
+{
+	uint32_t LISR;
+	uint32_t HISR;
+	uint32_t LIFCR;
+	uint32_t HIFCR;
+	h7dmastream_t S[8];
+};
+
+#define H7_DMA1					reinterpret_cast<volatile h7dma_t*>(0x40020000)
+#define H7_DMAMUX1_CCR			reinterpret_cast<volatile uint32_t*>(0x40020800)
+#define H7_RCC_AHB1ENR			reinterpret_cast<volatile uint32_t*>(0x580244d8)
+
+#define RCC_AHB1ENR_DMA1EN		0x00000001
+
+//DMA stream CR bits
+#define DMA_CR_EN				0x00000001
+#define DMA_CR_TEIE				0x00000004
+#define DMA_CR_TCIE				0x00000010
+#define DMA_CR_DIR_M2P			0x00000040
+#define DMA_CR_MINC				0x00000400
+#define DMA_CR_PL_LOW			0x00000000
+
+//Per-stream interrupt flags (before shifting into position within xISR/xIFCR)
+#define DMA_FLAG_FEIF			0x01
+#define DMA_FLAG_DMEIF			0x04
+#define DMA_FLAG_TEIF			0x08
+#define DMA_FLAG_HTIF			0x10
+#define DMA_FLAG_TCIF			0x20
+#define DMA_FLAG_ALL			0x3d
+
+//USART register offsets and bits
+#define USART_CR3				0x08
+#define USART_TDR				0x28
+#define USART_CR3_DMAT			0x00000080
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction / destruction
+
+/**
+	@brief Creates the backend
+
+	@param usart	Base address of the USART, e.g. &USART2
+	@param stream	DMA1 stream to use (0-7)
+	@param request	DMAMUX1 request ID for the USART TX request (see the DMAMUX chapter of the reference manual, e.g.
+					usart2_tx_dma is 44)
+ */
+STM32H7UARTDMA::STM32H7UARTDMA(volatile void* usart, uint32_t stream, uint32_t request)
+	: m_usart(reinterpret_cast<volatile uint8_t*>(usart))
+	, m_stream(stream)
+	, m_request(request)
+	, m_errors(0)
+{
+}
+
+/**
+	@brief Turns on DMA1, routes the USART TX request to our stream, and enables DMA requests in the USART
+ */
+void STM32H7UARTDMA::Initialize()
+{
+	*H7_RCC_AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+	asm volatile("dsb");
+
+	auto& s = H7_DMA1->S[m_stream];
+	s.CR = 0;
+	while(s.CR & DMA_CR_EN)
+	{}
+	ClearFlags();
+
+	//DMAMUX1 channels 0-7 feed DMA1 streams 0-7
+	H7_DMAMUX1_CCR[m_stream] = m_request;
+
+	//Byte transfers from memory to the USART data register, direct mode (FIFO disabled)
+	s.PAR = reinterpret_cast<uint32_t>(m_usart + USART_TDR);
+	s.FCR = 0;
+	s.CR = DMA_CR_DIR_M2P | DMA_CR_MINC | DMA_CR_PL_LOW;
+
+	*reinterpret_cast<volatile uint32_t*>(m_usart + USART_CR3) |= USART_CR3_DMAT;
+}
+
+/**
+	@brief Turns on the transfer complete and error interrupts (the BSP must enable the stream's IRQ in the NVIC)
+ */
+void STM32H7UARTDMA::EnableInterrupt()
+{
+	H7_DMA1->S[m_stream].CR |= DMA_CR_TCIE | DMA_CR_TEIE;
+}
+
+/**
+	@brief Gets the NVIC interrupt number of our DMA1 stream
+ */
+uint32_t STM32H7UARTDMA::GetIRQ() const
+{
+	//Streams 0-6 are contiguous, stream 7 was added later in the vector table
+	if(m_stream == 7)
+		return 47;
+	return 11 + m_stream;
+}
+
+/**
+	@brief Handles the stream interrupt
+ */
+void STM32H7UARTDMA::OnInterrupt()
+{
+	if(GetFlags() & (DMA_FLAG_TEIF | DMA_FLAG_DMEIF))
+		m_errors ++;
+	ClearFlags();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Flag helpers
+
+///@brief Bit position of a stream's flags within LISR/HISR/LIFCR/HIFCR
+static uint32_t GetFlagShift(uint32_t stream)
+{
+	static const uint8_t shifts[4] = {0, 6, 16, 22};
+	return shifts[stream & 3];
+}
+
+uint32_t STM32H7UARTDMA::GetFlags()
+{
+	uint32_t isr = (m_stream < 4) ? H7_DMA1->LISR : H7_DMA1->HISR;
+	return (isr >> GetFlagShift(m_stream)) & DMA_FLAG_ALL;
+}
+
+void STM32H7UARTDMA::ClearFlags()
+{
+	uint32_t mask = DMA_FLAG_ALL << GetFlagShift(m_stream);
+	if(m_stream < 4)
+		H7_DMA1->LIFCR = mask;
+	else
+		H7_DMA1->HIFCR = mask;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LogTxBackend interface
+
+bool STM32H7UARTDMA::IsBusy()
+{
+	return (H7_DMA1->S[m_stream].CR & DMA_CR_EN) != 0;
+}
+
+void STM32H7UARTDMA::Start(const uint8_t* buf, uint32_t len)
+{
+	//Make sure the DMA sees what the CPU wrote
+	#ifdef HAVE_L1
+		CleanDataCache(const_cast<uint8_t*>(buf), len);
+	#endif
+
+	//Count any error from the previous transfer, if we weren't using interrupts
+	if(GetFlags() & (DMA_FLAG_TEIF | DMA_FLAG_DMEIF))
+		m_errors ++;
+	ClearFlags();
+
+	auto& s = H7_DMA1->S[m_stream];
+	s.M0AR = reinterpret_cast<uint32_t>(buf);
+	s.NDTR = len;
+	s.CR |= DMA_CR_EN;
+}
+
+#endif
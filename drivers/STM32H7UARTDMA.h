@@ -0,0 +1,87 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef STM32H7UARTDMA_h
+#define STM32H7UARTDMA_h
+
+#ifdef STM32H7
+
+#include <core/BufferedLogDevice.h>
+
+/**
+	@brief LogTxBackend which sends through a USART TX DMA request on STM32H7 DMA1
+
+	Talks to the DMA1, DMAMUX1 and USART registers directly. The USART itself must already be set up (baud rate,
+	transmitter enabled), e.g. by the stm32-cpp UART driver. Nothing else may write to its TX data register while a
+	transfer is in progress, so console output should go through the same BufferedLogDevice.
+
+	DMA1 can't reach the TCMs, so buffers passed to Start() must be in AXI or AHB SRAM. They are cleaned from the data
+	cache before each transfer.
+
+	Works by polling (IsBusy() checks the stream enable bit, which hardware clears at the end of the transfer). To
+	start the next transfer from an interrupt instead, call EnableInterrupt(), enable GetIRQ() in the NVIC, and from the
+	DMA1 stream IRQ handler call OnInterrupt() and then BufferedLogDevice::Service().
+ */
+class STM32H7UARTDMA : public LogTxBackend
+{
+public:
+	STM32H7UARTDMA(volatile void* usart, uint32_t stream, uint32_t request);
+
+	void Initialize();
+	void EnableInterrupt();
+	void OnInterrupt();
+	uint32_t GetIRQ() const;
+
+	virtual bool IsBusy() override;
+	virtual void Start(const uint8_t* buf, uint32_t len) override;
+
+	///@brief Number of transfers completed with a DMA error
+	uint32_t GetErrorCount() const
+	{ return m_errors; }
+
+protected:
+	void ClearFlags();
+	uint32_t GetFlags();
+
+	///@brief Base address of the USART
+	volatile uint8_t* m_usart;
+
+	///@brief DMA1 stream number (0-7)
+	uint32_t m_stream;
+
+	///@brief DMAMUX1 request ID of the USART TX request
+	uint32_t m_request;
+
+	///@brief DMA transfer errors seen
+	uint32_t m_errors;
+};
+
+#endif
+
+#endif
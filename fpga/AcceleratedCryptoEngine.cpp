@@ -31,8 +31,16 @@
 #include "AcceleratedCryptoEngine.h"
 #include "../../../staticnet/contrib/tweetnacl_25519.h"
 
-//DEBUG
-//#define CRYPTO_PROFILE
+///@brief Set to debug to print how long each accelerated operation takes
+static LogCategory g_cryptoLog("crypto", LOG_LEVEL_NOTICE);
+
+///@brief Gets a timestamp for profiling, skipping the timer read if profiling is off
+static uint32_t ProfileTimestamp()
+{
+	if(LOG_ENABLED(g_cryptoLog, LOG_LEVEL_DEBUG))
+		return g_logTimer.GetCount();
+	return 0;
+}
 
 //curve25519 unpacked base point: {X, Y, gf1, X*Y}
 //(1 and x*y now computed on FPGA)
@@ -66,9 +74,7 @@ void AcceleratedCryptoEngine::PrintBlock(const char* keyname, const uint8_t* key
 
 void AcceleratedCryptoEngine::SharedSecret(uint8_t* sharedSecret, uint8_t* clientPublicKey)
 {
-	#ifdef CRYPTO_PROFILE
-	auto t1 = g_logTimer.GetCount();
-	#endif
+	auto t1 = ProfileTimestamp();
 
 	#ifdef QSPI_CACHE_WORKAROUND
 		g_apbfpga.BlockingWriteN(FCURVE25519.e, m_ephemeralkeyPriv, ECDH_KEY_SIZE);
@@ -93,10 +99,11 @@ void AcceleratedCryptoEngine::SharedSecret(uint8_t* sharedSecret, uint8_t* clien
 			shared[i] = FCURVE25519.data_out[i];
 	#endif
 
-	#ifdef CRYPTO_PROFILE
+	if(LOG_ENABLED(g_cryptoLog, LOG_LEVEL_DEBUG))
+	{
 		auto delta = g_logTimer.GetCount() - t1;
 		g_log("AcceleratedCryptoEngine::SharedSecret (FPGA acceleration): %d.%d ms\n", delta/10, delta%10);
-	#endif
+	}
 }
 
 /**
@@ -108,9 +115,7 @@ void AcceleratedCryptoEngine::SharedSecret(uint8_t* sharedSecret, uint8_t* clien
  */
 void AcceleratedCryptoEngine::GenerateX25519KeyPair(uint8_t* pub)
 {
-	#ifdef CRYPTO_PROFILE
-	auto t1 = g_logTimer.GetCount();
-	#endif
+	auto t1 = ProfileTimestamp();
 
 	//To be a valid key, a few bits need well-defined values. The rest are cryptographic randomness.
 	GenerateRandom(m_ephemeralkeyPriv, 32);
@@ -150,10 +155,11 @@ void AcceleratedCryptoEngine::GenerateX25519KeyPair(uint8_t* pub)
 			pubout[i] = FCURVE25519.data_out[i];
 	#endif
 
-	#ifdef CRYPTO_PROFILE
+	if(LOG_ENABLED(g_cryptoLog, LOG_LEVEL_DEBUG))
+	{
 		auto delta = g_logTimer.GetCount() - t1;
 		g_log("AcceleratedCryptoEngine::GenerateX25519KeyPair (FPGA acceleration): %d.%d ms\n", delta/10, delta%10);
-	#endif
+	}
 }
 
 /**
@@ -163,9 +169,7 @@ void AcceleratedCryptoEngine::GenerateX25519KeyPair(uint8_t* pub)
  */
 bool AcceleratedCryptoEngine::VerifySignature(uint8_t* signedMessage, uint32_t lengthIncludingSignature, uint8_t* publicKey)
 {
-	#ifdef CRYPTO_PROFILE
-	auto t1 = g_logTimer.GetCount();
-	#endif
+	auto t1 = ProfileTimestamp();
 
 	//fixed length cap
 	if(lengthIncludingSignature > 1024)
@@ -189,9 +193,7 @@ bool AcceleratedCryptoEngine::VerifySignature(uint8_t* signedMessage, uint32_t l
 	if (unpackneg(q, publicKey))
 		return false;
 
-	#ifdef CRYPTO_PROFILE
-	auto t2 = g_logTimer.GetCount();
-	#endif
+	auto t2 = ProfileTimestamp();
 
 	//Expanded public key for sending to accelerator
 	//TODO: can we move the expansion to the FPGA to save SPI BW and speed compute?
@@ -238,9 +240,7 @@ bool AcceleratedCryptoEngine::VerifySignature(uint8_t* signedMessage, uint32_t l
 		}
 	#endif
 
-	#ifdef CRYPTO_PROFILE
-	auto t3 = g_logTimer.GetCount();
-	#endif
+	auto t3 = ProfileTimestamp();
 
 	//scalarbase(q, signedMessage + 32);
 	#ifdef QSPI_CACHE_WORKAROUND
@@ -298,9 +298,7 @@ bool AcceleratedCryptoEngine::VerifySignature(uint8_t* signedMessage, uint32_t l
 
 	#endif
 
-	#ifdef CRYPTO_PROFILE
-	auto t4 = g_logTimer.GetCount();
-	#endif
+	auto t4 = ProfileTimestamp();
 
 	//Final addition... we really should try to keep this on the FPGA if possible
 	add(p,q);
@@ -312,20 +310,21 @@ bool AcceleratedCryptoEngine::VerifySignature(uint8_t* signedMessage, uint32_t l
 	if (crypto_verify_32(signedMessage, t))
 		return false;
 
-	#ifdef CRYPTO_PROFILE
-	auto tend = g_logTimer.GetCount();
-	auto delta = tend - t1;
-	g_log("AcceleratedCryptoEngine::VerifySignature (FPGA acceleration): %d.%d ms\n", delta/10, delta%10);
-	LogIndenter li(g_log);
-	delta = t2-t1;
-	g_log("Setup (no acceleration): %d.%d ms\n", delta/10, delta%10);
-	delta = t3-t2;
-	g_log("scalarmult (FPGA acceleration): %d.%d ms\n", delta/10, delta%10);
-	delta = t4-t3;
-	g_log("scalarbase (FPGA acceleration): %d.%d ms\n", delta/10, delta%10);
-	delta = tend-t4;
-	g_log("Final (no acceleration): %d.%d ms\n", delta/10, delta%10);
-	#endif
+	if(LOG_ENABLED(g_cryptoLog, LOG_LEVEL_DEBUG))
+	{
+		auto tend = g_logTimer.GetCount();
+		auto delta = tend - t1;
+		g_log("AcceleratedCryptoEngine::VerifySignature (FPGA acceleration): %d.%d ms\n", delta/10, delta%10);
+		LogIndenter li(g_log);
+		delta = t2-t1;
+		g_log("Setup (no acceleration): %d.%d ms\n", delta/10, delta%10);
+		delta = t3-t2;
+		g_log("scalarmult (FPGA acceleration): %d.%d ms\n", delta/10, delta%10);
+		delta = t4-t3;
+		g_log("scalarbase (FPGA acceleration): %d.%d ms\n", delta/10, delta%10);
+		delta = tend-t4;
+		g_log("Final (no acceleration): %d.%d ms\n", delta/10, delta%10);
+	}
 
 	return true;
 }
@@ -333,9 +332,7 @@ bool AcceleratedCryptoEngine::VerifySignature(uint8_t* signedMessage, uint32_t l
 ///@brief Signs an exchange hash with our host key
 void AcceleratedCryptoEngine::SignExchangeHash(uint8_t* sigOut, uint8_t* exchangeHash)
 {
-	#ifdef CRYPTO_PROFILE
-	auto t1 = g_logTimer.GetCount();
-	#endif
+	auto t1 = ProfileTimestamp();
 
 	//Hash the private key and massage it to make sure it's a valid curve point
 	uint8_t privkeyHash[64];
@@ -426,8 +423,9 @@ void AcceleratedCryptoEngine::SignExchangeHash(uint8_t* sigOut, uint8_t* exchang
 	modL(sm + 32,x);
 	memcpy(sigOut, sm, 64);
 
-	#ifdef CRYPTO_PROFILE
-	auto delta = g_logTimer.GetCount() - t1;
-	g_log("AcceleratedCryptoEngine::SignExchangeHash (FPGA acceleration): %d.%d ms\n", delta/10, delta%10);
-	#endif
+	if(LOG_ENABLED(g_cryptoLog, LOG_LEVEL_DEBUG))
+	{
+		auto delta = g_logTimer.GetCount() - t1;
+		g_log("AcceleratedCryptoEngine::SignExchangeHash (FPGA acceleration): %d.%d ms\n", delta/10, delta%10);
+	}
 }
@@ -33,6 +33,9 @@
 ///@brief SPI flash controller for FPGA (must be initialized by application code)
 APB_SpiFlashInterface* g_fpgaFlash = nullptr;
 
+///@brief Set to verbose to get more extensive debug info about bitstream structure
+static LogCategory g_fpgaUpdateLog("fpgaupdate", LOG_LEVEL_NOTICE);
+
 const uint8_t g_syncword[4] = { 0xaa, 0x99, 0x55, 0x66 };
 
 const char* g_fpgaRegNames[32] =
@@ -331,9 +334,6 @@ void FPGAFirmwareUpdater::PushWriteData()
  */
 bool FPGAFirmwareUpdater::ProcessDataFromBuffer()
 {
-	//Turn on to get more extensive debug info about bitstream structure
-	const bool verbosePrint = false;
-
 	const unsigned char magic[13] =
 	{
 		0x00, 0x09, 0x0f, 0xf0, 0x0f, 0xf0, 0x0f, 0xf0, 0x0f, 0xf0, 0x00, 0x00, 0x01
@@ -456,8 +456,7 @@ bool FPGAFirmwareUpdater::ProcessDataFromBuffer()
 				//If we found the sync word, we're done with the padding/bus width
 				if(0 == memcmp(ptr, g_syncword, sizeof(g_syncword)))
 				{
-					if(verbosePrint)
-						g_log("Found sync word\n");
+					LOG_VERBOSE(g_fpgaUpdateLog, "Found sync word\n");
 					m_writeBuffer.Push(ptr, sizeof(g_syncword));
 					m_rxBuffer.Pop(sizeof(g_syncword));
 					m_state = STATE_BITSTREAM;
@@ -516,8 +515,7 @@ bool FPGAFirmwareUpdater::ProcessDataFromBuffer()
 					else if( (len == 1) && (regaddr == REG_CMD))
 					{
 						auto cmd = __builtin_bswap32(pheader[1]) & 0x1f;
-						if(verbosePrint)
-							g_log("Command: %02x (%s)\n", cmd, g_cmdNames[cmd]);
+						LOG_VERBOSE(g_fpgaUpdateLog, "Command: %02x (%s)\n", cmd, g_cmdNames[cmd]);
 
 						//we're finished after this word
 						if(cmd == CMD_DESYNC)
@@ -525,15 +523,12 @@ bool FPGAFirmwareUpdater::ProcessDataFromBuffer()
 					}
 					else if(len == 1)
 					{
-						if(verbosePrint)
-						{
-							g_log("Type 1 %s to %04x (%7s): %08x\n",
-								ops[op], regaddr, g_fpgaRegNames[regaddr], __builtin_bswap32(pheader[1]));
-						}
+						LOG_VERBOSE(g_fpgaUpdateLog, "Type 1 %s to %04x (%7s): %08x\n",
+							ops[op], regaddr, g_fpgaRegNames[regaddr], __builtin_bswap32(pheader[1]));
 					}
 					else
 					{
-						if(verbosePrint)
+						if(LOG_ENABLED(g_fpgaUpdateLog, LOG_LEVEL_VERBOSE))
 						{
 							g_log("Type 1 %s to %04x (%7s): %d words\n", ops[op], regaddr, g_fpgaRegNames[regaddr], len);
 							LogIndenter li(g_log);
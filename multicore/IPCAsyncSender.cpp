@@ -0,0 +1,169 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include "IPCAsyncSender.h"
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+
+/**
+	@file
+	@brief Implementation of IPCAsyncSender
+ */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction / destruction
+
+IPCAsyncSender::IPCAsyncSender(UnidirectionalIPCFifo* fifo)
+	: Task(false)
+	, m_fifo(fifo)
+	, m_dispatcher(nullptr)
+	, m_head(0)
+	, m_tail(0)
+	, m_drops(0)
+	, m_overflows(0)
+	, m_highWater(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Sending
+
+/**
+	@brief Sends a message without blocking
+
+	@return False if the message had to be dropped
+ */
+bool IPCAsyncSender::Send(const uint8_t* buf, uint32_t size)
+{
+	if(!m_fifo)
+		return false;
+	if(size == 0)
+		return true;
+
+	//Fast path: nothing queued ahead of us, so try to send directly
+	if(!IsBusy())
+	{
+		switch(m_fifo->TryPush(buf, size))
+		{
+			case IPC_PUSH_OK:
+				return true;
+
+			case IPC_PUSH_TOO_BIG:
+				m_overflows ++;
+				return false;
+
+			default:
+				break;
+		}
+	}
+	else if(size > m_fifo->size())
+	{
+		m_overflows ++;
+		return false;
+	}
+
+	//Queue is empty, start over at the beginning so we don't have to wrap
+	if(!IsBusy())
+	{
+		m_head = 0;
+		m_tail = 0;
+	}
+
+	//Figure out where the message goes, skipping the end of the queue if it won't fit before the wrap
+	uint32_t rec = RecordSize(size);
+	uint32_t used = m_tail - m_head;
+	uint32_t tail = IPC_ASYNC_QUEUE_SIZE - (m_tail & (IPC_ASYNC_QUEUE_SIZE - 1));
+	uint32_t skip = 0;
+	if(rec > tail)
+		skip = tail;
+	if( (used + skip + rec) > IPC_ASYNC_QUEUE_SIZE)
+	{
+		m_drops ++;
+		return false;
+	}
+
+	//Write it
+	if(skip)
+		*GetHeader(m_tail) = 0;
+	uint32_t start = m_tail + skip;
+	auto hdr = GetHeader(start);
+	*hdr = size;
+	memcpy(hdr + 1, buf, size);
+	m_tail = start + rec;
+
+	used = m_tail - m_head;
+	if(used > m_highWater)
+		m_highWater = used;
+
+	//Make sure we get run to drain it
+	ScheduleRetry();
+	return true;
+}
+
+/**
+	@brief Pushes as many queued messages as the FIFO will accept right now
+ */
+void IPCAsyncSender::Iteration()
+{
+	while(IsBusy())
+	{
+		//Skip wrap markers
+		auto hdr = GetHeader(m_head);
+		if(*hdr == 0)
+		{
+			m_head += IPC_ASYNC_QUEUE_SIZE - (m_head & (IPC_ASYNC_QUEUE_SIZE - 1));
+			continue;
+		}
+
+		uint32_t len = *hdr;
+		if(m_fifo->TryPush(reinterpret_cast<const uint8_t*>(hdr + 1), len) == IPC_PUSH_WOULD_BLOCK)
+			break;
+		m_head += RecordSize(len);
+	}
+
+	//Still have stuff to send? Come back when the FIFO is free
+	if(IsBusy())
+		ScheduleRetry();
+}
+
+/**
+	@brief Arranges for Iteration() to be called once the FIFO might be free again
+ */
+void IPCAsyncSender::ScheduleRetry()
+{
+	if(m_dispatcher)
+		m_dispatcher->ArmTx(m_fifo->GetChannel(), this);
+	else
+		Wake();
+}
+
+#endif
+#endif
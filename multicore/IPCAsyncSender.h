@@ -0,0 +1,134 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef IPCAsyncSender_h
+#define IPCAsyncSender_h
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+
+#include "IPCDescriptorTable.h"
+#include "IPCInterruptDispatcher.h"
+
+#ifndef IPC_ASYNC_QUEUE_SIZE
+#define IPC_ASYNC_QUEUE_SIZE 1024
+#endif
+
+static_assert( (IPC_ASYNC_QUEUE_SIZE & (IPC_ASYNC_QUEUE_SIZE - 1)) == 0, "IPC_ASYNC_QUEUE_SIZE must be a power of two");
+
+/**
+	@brief Non-blocking sender for a UnidirectionalIPCFifo
+
+	Send() pushes the message straight into the FIFO if it's free, and otherwise copies it into a local queue. The
+	queue is drained by Iteration() as the peer frees up the FIFO, so the caller never waits on the other core.
+
+	If the local queue is full the message is dropped and counted, rather than stalling.
+
+	The sender is an event-driven task: it's only run while there's something queued. It must be added to the task
+	list of the core that calls Send(). If an interrupt dispatcher is attached it sleeps until the TX free interrupt
+	while the FIFO is busy, otherwise it re-polls the FIFO every pass through the main loop.
+ */
+class IPCAsyncSender : public Task
+{
+public:
+	IPCAsyncSender(UnidirectionalIPCFifo* fifo = nullptr);
+
+	void SetFifo(UnidirectionalIPCFifo* fifo)
+	{ m_fifo = fifo; }
+
+	///@brief Use TX free interrupts, rather than polling, to find out when the FIFO drains
+	void SetInterruptDispatcher(IPCInterruptDispatcher* dispatcher)
+	{ m_dispatcher = dispatcher; }
+
+	bool Send(const uint8_t* buf, uint32_t size);
+
+	virtual void Iteration() override;
+
+	///@brief Returns true if there are messages waiting to go out
+	bool IsBusy() const
+	{ return m_head != m_tail; }
+
+	///@brief Number of messages dropped because the local queue was full
+	uint32_t GetDropCount() const
+	{ return m_drops; }
+
+	///@brief Number of messages dropped because they were larger than the FIFO
+	uint32_t GetOverflowCount() const
+	{ return m_overflows; }
+
+	///@brief Most bytes ever waiting in the local queue
+	uint32_t GetQueueHighWater() const
+	{ return m_highWater; }
+
+	void ClearCounters()
+	{
+		m_drops = 0;
+		m_overflows = 0;
+		m_highWater = 0;
+	}
+
+protected:
+	void ScheduleRetry();
+
+	///@brief Size of a queued message record, including the length header and padding
+	static uint32_t RecordSize(uint32_t len)
+	{ return (len + sizeof(uint32_t) + 3) & ~3; }
+
+	uint32_t* GetHeader(uint32_t index)
+	{ return reinterpret_cast<uint32_t*>(m_queue + (index & (IPC_ASYNC_QUEUE_SIZE - 1))); }
+
+	///@brief The FIFO we're sending to
+	UnidirectionalIPCFifo* m_fifo;
+
+	///@brief Interrupt dispatcher to request TX free wakeups from (null to poll)
+	IPCInterruptDispatcher* m_dispatcher;
+
+	///@brief Messages waiting to be sent (32-bit length followed by data, with a zero length marking a wrap)
+	uint8_t m_queue[IPC_ASYNC_QUEUE_SIZE] __attribute__((aligned(4)));
+
+	///@brief Index of the oldest queued message
+	uint32_t m_head;
+
+	///@brief Index at which the next message will be queued
+	uint32_t m_tail;
+
+	///@brief Messages dropped due to the queue being full
+	uint32_t m_drops;
+
+	///@brief Messages dropped due to being larger than the FIFO
+	uint32_t m_overflows;
+
+	///@brief Queue high-water mark
+	uint32_t m_highWater;
+};
+
+#endif
+#endif
+
+#endif
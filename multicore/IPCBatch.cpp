@@ -0,0 +1,220 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include "IPCBatch.h"
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+
+/**
+	@file
+	@brief Implementation of IPCBatchSender
+ */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction / destruction
+
+IPCBatchSender::IPCBatchSender(UnidirectionalIPCFifo* fifo)
+	: Task(false)
+	, m_fifo(fifo)
+	, m_dispatcher(nullptr)
+	, m_used(0)
+	, m_pending(0)
+	, m_batches(0)
+	, m_messages(0)
+	, m_drops(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Sending
+
+/**
+	@brief Max number of bytes we can put in one batch
+ */
+uint32_t IPCBatchSender::GetCapacity()
+{
+	uint32_t cap = m_fifo->size();
+	if(cap > IPC_BATCH_BUFFER_SIZE)
+		cap = IPC_BATCH_BUFFER_SIZE;
+	return cap;
+}
+
+/**
+	@brief Adds a message to the current batch, and pushes the batch if the FIFO is free
+
+	@return False if the message was dropped (staging buffer full, or message bigger than a whole batch)
+ */
+bool IPCBatchSender::Send(const uint8_t* msg, uint16_t len)
+{
+	if(!m_fifo)
+		return false;
+
+	uint32_t rec = len + HEADER_SIZE;
+	uint32_t cap = GetCapacity();
+
+	//If it doesn't fit in what's left, try to make room
+	if( (m_used + rec) > cap)
+		Flush();
+	if( (m_used + rec) > cap)
+	{
+		m_drops ++;
+		return false;
+	}
+
+	//Append it
+	m_staging[m_used] = len & 0xff;
+	m_staging[m_used + 1] = len >> 8;
+	memcpy(m_staging + m_used + HEADER_SIZE, msg, len);
+	m_used += rec;
+	m_pending ++;
+
+	//Send right away if we can, otherwise come back when the FIFO is free
+	if(!Flush())
+	{
+		if(m_dispatcher)
+			m_dispatcher->ArmTx(m_fifo->GetChannel(), this);
+		else
+			Wake();
+	}
+	return true;
+}
+
+/**
+	@brief Pushes the current batch, if there is one and the FIFO is free
+
+	@return True if nothing is left pending
+ */
+bool IPCBatchSender::Flush()
+{
+	if(m_used == 0)
+		return true;
+
+	if(m_fifo->TryPush(m_staging, m_used) != IPC_PUSH_OK)
+		return false;
+
+	m_batches ++;
+	m_messages += m_pending;
+	m_used = 0;
+	m_pending = 0;
+	return true;
+}
+
+void IPCBatchSender::Iteration()
+{
+	if(Flush())
+		return;
+
+	if(m_dispatcher)
+		m_dispatcher->ArmTx(m_fifo->GetChannel(), this);
+	else
+		Wake();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Benchmarking
+
+/**
+	@brief Gets the time for the benchmark loops, standing in for the main loop's timebase update while we block it
+
+	Without this, a 16-bit log timer could wrap partway through a run on the timebase core, making GetTicks() jump
+	backwards.
+ */
+static uint64_t BenchmarkNow()
+{
+	//The host simulation's log timer doesn't wrap, and its logger can't rebase it
+	#ifndef IPC_HOST_SIMULATION
+		#ifdef MULTICORE
+		if(GetCurrentCore() == 0)
+		#endif
+			g_timebase.Update(TIMEBASE_REBASE_THRESHOLD);
+	#endif
+
+	return g_timebase.GetTicks();
+}
+
+/**
+	@brief Measures IPC throughput, with and without batching, for a range of message sizes
+
+	Needs the peer to be draining the FIFO (any receiver will do, the contents are junk). Blocks for
+	2 * msecPerSize per message size, then logs messages/s, bytes/s and doorbells/s for each case.
+
+	Timed on g_timebase. We block the main loop, so if this is the core that maintains g_timebase the timing loops
+	rebase the log timer themselves (see BenchmarkNow()), and any msecPerSize works.
+ */
+void IPCBatchBenchmark(UnidirectionalIPCFifo* fifo, uint32_t msecPerSize)
+{
+	static const uint16_t sizes[] = { 8, 32, 128, 512 };
+	static uint8_t payload[512];
+	static IPCBatchSender sender;
+	sender.SetFifo(fifo);
+
+	g_log("IPC batching benchmark (FIFO size %u, %u ms per test)\n", fifo->size(), msecPerSize);
+	LogIndenter li(g_log);
+	g_log("%-7s | %5s | %10s | %12s | %10s\n", "Mode", "Size", "Msgs/s", "Bytes/s", "Pushes/s");
+
+	//Timebase is 10 kHz
+	uint64_t ticks = msecPerSize * 10ULL;
+	for(auto size : sizes)
+	{
+		if( (size + IPCBatchSender::HEADER_SIZE) > fifo->size())
+			continue;
+
+		//Baseline: one push per message
+		uint32_t count = 0;
+		auto start = BenchmarkNow();
+		while( (BenchmarkNow() - start) < ticks)
+		{
+			if(fifo->TryPush(payload, size) == IPC_PUSH_OK)
+				count ++;
+		}
+		uint64_t rate = count * 1000ULL / msecPerSize;
+		g_log("%-7s | %5u | %10u | %12u | %10u\n",
+			"single", size, (uint32_t)rate, (uint32_t)(rate * size), (uint32_t)rate);
+
+		//Batched
+		sender.ClearCounters();
+		start = BenchmarkNow();
+		while( (BenchmarkNow() - start) < ticks)
+		{
+			if(!sender.Send(payload, size))
+				sender.Flush();
+		}
+		while(!sender.Flush())
+		{}
+		rate = sender.GetMessageCount() * 1000ULL / msecPerSize;
+		uint64_t pushes = sender.GetBatchCount() * 1000ULL / msecPerSize;
+		g_log("%-7s | %5u | %10u | %12u | %10u\n",
+			"batched", size, (uint32_t)rate, (uint32_t)(rate * size), (uint32_t)pushes);
+	}
+}
+
+#endif
+#endif
@@ -0,0 +1,169 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef IPCBatch_h
+#define IPCBatch_h
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+
+#include "IPCDescriptorTable.h"
+#include "IPCInterruptDispatcher.h"
+
+#ifndef IPC_BATCH_BUFFER_SIZE
+#define IPC_BATCH_BUFFER_SIZE 1024
+#endif
+
+/**
+	@brief Packs many small messages into each UnidirectionalIPCFifo push
+
+	Each message is framed as a 16-bit little endian length followed by the payload, with no padding. The receiver
+	unpacks a popped buffer with IPCBatchReader.
+
+	Send() pushes immediately if the FIFO is free, so a lone message sees no extra latency. While the peer is still
+	busy with the previous buffer, messages accumulate in a local staging buffer and all go out in the next push, so
+	under load the cost of the IPCC handshake and cache maintenance is shared by the whole batch.
+
+	Event-driven task: must be added to the task list of the core calling Send() so batches get flushed once the FIFO
+	frees up.
+ */
+class IPCBatchSender : public Task
+{
+public:
+	IPCBatchSender(UnidirectionalIPCFifo* fifo = nullptr);
+
+	void SetFifo(UnidirectionalIPCFifo* fifo)
+	{ m_fifo = fifo; }
+
+	///@brief Use TX free interrupts, rather than polling, to find out when the FIFO drains
+	void SetInterruptDispatcher(IPCInterruptDispatcher* dispatcher)
+	{ m_dispatcher = dispatcher; }
+
+	bool Send(const uint8_t* msg, uint16_t len);
+	bool Flush();
+
+	virtual void Iteration() override;
+
+	///@brief Number of FIFO pushes (doorbells) done
+	uint32_t GetBatchCount() const
+	{ return m_batches; }
+
+	///@brief Number of messages pushed
+	uint32_t GetMessageCount() const
+	{ return m_messages; }
+
+	///@brief Number of messages dropped because the staging buffer was full
+	uint32_t GetDropCount() const
+	{ return m_drops; }
+
+	void ClearCounters()
+	{
+		m_batches = 0;
+		m_messages = 0;
+		m_drops = 0;
+	}
+
+	///@brief Framing overhead per message
+	static const uint32_t HEADER_SIZE = 2;
+
+protected:
+	uint32_t GetCapacity();
+
+	///@brief The FIFO we're sending to
+	UnidirectionalIPCFifo* m_fifo;
+
+	///@brief Interrupt dispatcher to request TX free wakeups from (null to poll)
+	IPCInterruptDispatcher* m_dispatcher;
+
+	///@brief Messages waiting for the next push
+	uint8_t m_staging[IPC_BATCH_BUFFER_SIZE];
+
+	///@brief Number of bytes used in m_staging
+	uint32_t m_used;
+
+	///@brief Number of messages in m_staging
+	uint32_t m_pending;
+
+	///@brief Number of pushes done
+	uint32_t m_batches;
+
+	///@brief Number of messages pushed
+	uint32_t m_messages;
+
+	///@brief Number of messages dropped
+	uint32_t m_drops;
+};
+
+/**
+	@brief Walks the messages in a buffer popped from a channel fed by IPCBatchSender
+
+	Message pointers point into the popped buffer (no copy), and are not aligned.
+ */
+class IPCBatchReader
+{
+public:
+	IPCBatchReader(const uint8_t* buf, uint32_t len)
+		: m_buf(buf)
+		, m_len(len)
+		, m_offset(0)
+	{}
+
+	/**
+		@brief Gets the next message
+
+		@return False if there are no more (or the rest of the buffer is malformed)
+	 */
+	bool Next(const uint8_t*& msg, uint16_t& len)
+	{
+		if( (m_offset + IPCBatchSender::HEADER_SIZE) > m_len)
+			return false;
+
+		uint16_t n = m_buf[m_offset] | (m_buf[m_offset + 1] << 8);
+		uint32_t start = m_offset + IPCBatchSender::HEADER_SIZE;
+		if( (start + n) > m_len)
+			return false;
+
+		msg = m_buf + start;
+		len = n;
+		m_offset = start + n;
+		return true;
+	}
+
+protected:
+	const uint8_t* m_buf;
+	uint32_t m_len;
+	uint32_t m_offset;
+};
+
+void IPCBatchBenchmark(UnidirectionalIPCFifo* fifo, uint32_t msecPerSize = 1000);
+
+#endif
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include "IPCBufferPool.h"
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+#if IPC_POOL_NUM_BLOCKS > 0
+
+/**
+	@file
+	@brief Implementation of IPCBufferPool
+ */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The pool
+
+__attribute__((section(".ipcdescriptors"))) IPCBufferPool g_ipcBufferPool;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction / destruction
+
+/**
+	@brief Puts every block on the free list (primary core only, the secondary sees the state the primary set up)
+ */
+IPCBufferPool::IPCBufferPool()
+{
+	#ifdef PRIMARY_CORE
+		for(uint32_t i=0; i<IPC_POOL_NUM_BLOCKS; i++)
+			m_next[i] = i + 1;
+		m_next[IPC_POOL_NUM_BLOCKS - 1] = IPC_BUFFER_NONE;
+
+		m_head = 0;
+		m_freeCount = IPC_POOL_NUM_BLOCKS;
+		m_lowWater = IPC_POOL_NUM_BLOCKS;
+	#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Allocation
+
+/**
+	@brief Takes a block off the free list
+
+	@return Handle to the block, or IPC_BUFFER_NONE if the pool is empty
+ */
+IPCBufferHandle IPCBufferPool::Allocate()
+{
+	uint32_t head = __atomic_load_n(&m_head, __ATOMIC_ACQUIRE);
+	uint32_t next;
+	IPCBufferHandle handle;
+	do
+	{
+		handle = head & INDEX_MASK;
+		if(handle == IPC_BUFFER_NONE)
+			return IPC_BUFFER_NONE;
+
+		//If another core takes this block first, m_next may be garbage, but then the tag has changed and the CAS fails
+		next = ( (head + TAG_INCREMENT) & ~INDEX_MASK) | __atomic_load_n(&m_next[handle], __ATOMIC_RELAXED);
+
+	} while(!__atomic_compare_exchange_n(&m_head, &head, next, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+	//Update stats
+	uint32_t nfree = __atomic_sub_fetch(&m_freeCount, 1, __ATOMIC_RELAXED);
+	uint32_t low = __atomic_load_n(&m_lowWater, __ATOMIC_RELAXED);
+	while( (nfree < low) &&
+		!__atomic_compare_exchange_n(&m_lowWater, &low, nfree, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+	{}
+
+	return handle;
+}
+
+/**
+	@brief Puts a block back on the free list
+ */
+void IPCBufferPool::Free(IPCBufferHandle handle)
+{
+	if(handle >= IPC_POOL_NUM_BLOCKS)
+		return;
+
+	uint32_t head = __atomic_load_n(&m_head, __ATOMIC_ACQUIRE);
+	uint32_t next;
+	do
+	{
+		__atomic_store_n(&m_next[handle], head & INDEX_MASK, __ATOMIC_RELAXED);
+		next = ( (head + TAG_INCREMENT) & ~INDEX_MASK) | handle;
+
+	} while(!__atomic_compare_exchange_n(&m_head, &head, next, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+	__atomic_add_fetch(&m_freeCount, 1, __ATOMIC_RELAXED);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Diagnostics
+
+void IPCBufferPool::Print()
+{
+	g_log("IPC buffer pool: %u blocks of %u bytes at " PTR_FMT ", %u free (low water %u)\n",
+		IPC_POOL_NUM_BLOCKS,
+		IPC_POOL_BLOCK_SIZE,
+		PTR_ARGS(m_blocks[0]),
+		GetFreeCount(),
+		GetLowWater());
+}
+
+#endif
+#endif
+#endif
@@ -0,0 +1,148 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef IPCBufferPool_h
+#define IPCBufferPool_h
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+
+#include "IPCCache.h"
+
+#ifndef IPC_POOL_NUM_BLOCKS
+#define IPC_POOL_NUM_BLOCKS 0
+#endif
+
+#ifndef IPC_POOL_BLOCK_SIZE
+#define IPC_POOL_BLOCK_SIZE 1536
+#endif
+
+#if IPC_POOL_NUM_BLOCKS > 0
+
+static_assert(IPC_POOL_NUM_BLOCKS < 0xffff, "IPC_POOL_NUM_BLOCKS must fit in a 16-bit handle");
+static_assert( (IPC_POOL_BLOCK_SIZE % IPC_CACHE_LINE_SIZE) == 0, "IPC_POOL_BLOCK_SIZE must be a whole number of cache lines");
+
+///@brief Handle to a block in the shared buffer pool (an index, so it means the same thing on every core)
+typedef uint16_t IPCBufferHandle;
+
+///@brief Handle value meaning "no block"
+#define IPC_BUFFER_NONE 0xffff
+
+/**
+	@brief Fixed-block allocator for buffers shared between cores
+
+	Lets one core allocate a buffer, fill it in place, and hand it to the other core by sending just the handle over an
+	IPC channel, instead of copying the data into the channel's FIFO. Whoever holds the handle owns the block, and
+	either core may free it.
+
+	Typical flow:
+	* Sender: Allocate(), write to GetBuffer(), Clean(), send the handle
+	* Receiver: get the handle, Invalidate(), read from GetBuffer(), Free()
+
+	The free list is a Treiber stack. The head word packs the index of the top block with a 16-bit tag which is bumped
+	on every update, so a pop racing with a pop-push of the same block (ABA) fails its compare-and-swap rather than
+	corrupting the list. Allocate() and Free() use __atomic CAS, which compiles to LDREX/STREX on armv8-m and exclusive
+	or LSE atomics on aarch64, so they're lock-free and safe to call from either core and from interrupt context.
+
+	The exclusive monitor only works across cores if the pool is in memory which is shared and non-cacheable (or
+	hardware coherent) on both sides, so the BSP's linker script and MPU/MMU setup must map .ipcdescriptors that way.
+	Block contents can still be cached; that's what Clean() and Invalidate() are for.
+
+	Lives in .ipcdescriptors next to g_ipcDescriptorTable and, like it, is only initialized by the primary core.
+
+	Must use stdint types only, and be structured to have the same memory layout on armv8-m and aarch64.
+ */
+class IPCBufferPool
+{
+public:
+	IPCBufferPool();
+
+	IPCBufferHandle Allocate();
+	void Free(IPCBufferHandle handle);
+
+	///@brief Gets a pointer to a block
+	uint8_t* GetBuffer(IPCBufferHandle handle)
+	{ return m_blocks[handle]; }
+
+	///@brief Gets the handle of the block containing a pointer
+	IPCBufferHandle GetHandle(const uint8_t* ptr)
+	{ return (ptr - m_blocks[0]) / IPC_POOL_BLOCK_SIZE; }
+
+	///@brief Size of each block, in bytes
+	static uint32_t GetBlockSize()
+	{ return IPC_POOL_BLOCK_SIZE; }
+
+	///@brief Writes back len bytes of a block before handing it to the other core
+	void Clean(IPCBufferHandle handle, uint32_t len)
+	{ IPCCleanRange(m_blocks[handle], len); }
+
+	///@brief Discards stale cached copies of len bytes of a block received from the other core
+	void Invalidate(IPCBufferHandle handle, uint32_t len)
+	{ IPCInvalidateRange(m_blocks[handle], len); }
+
+	///@brief Number of blocks currently free (approximate, if the other core is allocating at the same time)
+	uint32_t GetFreeCount()
+	{ return __atomic_load_n(&m_freeCount, __ATOMIC_RELAXED); }
+
+	///@brief Fewest blocks ever free
+	uint32_t GetLowWater()
+	{ return __atomic_load_n(&m_lowWater, __ATOMIC_RELAXED); }
+
+	void Print();
+
+protected:
+	///@brief Mask for the block index in m_head
+	static const uint32_t INDEX_MASK = 0xffff;
+
+	///@brief Amount to add to m_head to bump the tag
+	static const uint32_t TAG_INCREMENT = 0x10000;
+
+	///@brief Top of the free list (tag in the high half, index of the first free block in the low half)
+	uint32_t m_head __attribute__((aligned(IPC_CACHE_LINE_SIZE)));
+
+	///@brief Number of free blocks
+	uint32_t m_freeCount;
+
+	///@brief Fewest free blocks seen
+	uint32_t m_lowWater;
+
+	///@brief Index of the next free block after each free block (IPC_BUFFER_NONE at the end of the list)
+	uint16_t m_next[IPC_POOL_NUM_BLOCKS];
+
+	///@brief The blocks themselves
+	uint8_t m_blocks[IPC_POOL_NUM_BLOCKS][IPC_POOL_BLOCK_SIZE] __attribute__((aligned(IPC_CACHE_LINE_SIZE)));
+};
+
+extern "C" IPCBufferPool g_ipcBufferPool;
+
+#endif
+#endif
+#endif
+
+#endif
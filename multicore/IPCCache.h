@@ -0,0 +1,195 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef IPCCache_h
+#define IPCCache_h
+
+#include <stdint.h>
+
+#ifdef IPC_HOST_SIMULATION
+#include <sched.h>
+#endif
+
+/**
+	@file
+	@brief Cache maintenance for IPC buffers shared between cores that are not cache coherent with each other
+
+	Operations work on whole cache lines covering the requested range, so only the lines actually touched are
+	maintained (rather than the whole cache, or a rounded-up guess at the range).
+
+	For this to be safe with buffers in cacheable memory, every shared buffer and every shared control field written
+	by one side must start and end on an IPC_CACHE_LINE_SIZE boundary. Otherwise invalidating on the receive side
+	could discard, or cleaning could overwrite, unrelated data sharing a line with the buffer.
+
+	When IPC_HOST_SIMULATION is defined (see multicore/host), cache maintenance is a no-op and barriers and shared index
+	accesses map to C++ atomics, so the IPC code can run between threads on a PC.
+ */
+
+///@brief Largest cache line size of any core that might share a buffer (A35 is 64 bytes, Cortex-M7 is 32)
+#define IPC_CACHE_LINE_SIZE 64
+
+#ifdef __aarch64__
+	#define IPC_LOCAL_CACHE_LINE_SIZE 64
+#else
+	#define IPC_LOCAL_CACHE_LINE_SIZE 32
+#endif
+
+///@brief Cortex-M SCB cache maintenance by address registers
+#define SCB_DCIMVAC		reinterpret_cast<volatile uint32_t*>(0xe000ef5c)
+#define SCB_DCCMVAC		reinterpret_cast<volatile uint32_t*>(0xe000ef68)
+
+/**
+	@brief Returns true if a pointer is aligned to IPC_CACHE_LINE_SIZE
+ */
+static inline bool IsIPCCacheAligned(const volatile void* p)
+{ return (reinterpret_cast<uintptr_t>(p) & (IPC_CACHE_LINE_SIZE - 1)) == 0; }
+
+/**
+	@brief Returns true if a buffer both starts and ends on an IPC_CACHE_LINE_SIZE boundary
+ */
+static inline bool IsIPCCacheAligned(const volatile void* p, uint32_t len)
+{ return IsIPCCacheAligned(p) && ( (len & (IPC_CACHE_LINE_SIZE - 1)) == 0); }
+
+/**
+	@brief Full memory barrier between accesses to memory shared with the other core
+
+	In the host simulation all cross-thread ordering comes from the atomic index and IPCC accesses, so this only has to
+	stop the compiler reordering (and avoids fences, which ThreadSanitizer doesn't model).
+ */
+static inline void IPCMemoryBarrier()
+{
+	#ifdef IPC_HOST_SIMULATION
+		__atomic_signal_fence(__ATOMIC_SEQ_CST);
+	#else
+		asm volatile("dmb sy" ::: "memory");
+	#endif
+}
+
+/**
+	@brief Reads an index written by the other core
+
+	A plain volatile read on hardware, where ordering comes from the explicit barriers around it. The host simulation
+	uses a sequentially consistent atomic load instead, which also gives the store-to-load ordering the doorbell logic
+	relies on, and lets ThreadSanitizer see the synchronization.
+ */
+static inline uint32_t IPCLoadShared(const volatile uint32_t& v)
+{
+	#ifdef IPC_HOST_SIMULATION
+		return __atomic_load_n(&v, __ATOMIC_SEQ_CST);
+	#else
+		return v;
+	#endif
+}
+
+/**
+	@brief Writes an index read by the other core (sequentially consistent store in the host simulation)
+ */
+static inline void IPCStoreShared(volatile uint32_t& v, uint32_t value)
+{
+	#ifdef IPC_HOST_SIMULATION
+		__atomic_store_n(&v, value, __ATOMIC_SEQ_CST);
+	#else
+		v = value;
+	#endif
+}
+
+/**
+	@brief Called on each pass through a loop that is waiting for the other core
+
+	Nothing to do on hardware, where the other core runs in parallel. The host simulation may have fewer CPUs than
+	simulated cores, so there it gives up the CPU to let the other side make progress.
+ */
+static inline void IPCSpinWait()
+{
+	#ifdef IPC_HOST_SIMULATION
+		sched_yield();
+	#endif
+}
+
+/**
+	@brief Writes back any dirty lines in a range so the other side can see our writes
+ */
+static inline void IPCCleanRange(const volatile void* p, uint32_t len)
+{
+	#if (defined(__aarch64__) || defined(HAVE_L1)) && !defined(IPC_HOST_SIMULATION)
+		if(len == 0)
+			return;
+
+		uintptr_t start = reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(IPC_LOCAL_CACHE_LINE_SIZE - 1);
+		uintptr_t end = reinterpret_cast<uintptr_t>(p) + len;
+
+		for(uintptr_t addr = start; addr < end; addr += IPC_LOCAL_CACHE_LINE_SIZE)
+		{
+			#ifdef __aarch64__
+				asm volatile("dc cvac, %0" :: "r"(addr) : "memory");
+			#else
+				*SCB_DCCMVAC = addr;
+			#endif
+		}
+
+		//Wait for the writeback to finish before anything else (e.g. a doorbell) can be observed
+		asm volatile("dsb sy" ::: "memory");
+	#else
+		(void)p;
+		(void)len;
+	#endif
+}
+
+/**
+	@brief Discards any cached copy of a range so we read what the other side wrote
+
+	The range must be cache line aligned on both ends (see file docs), since any dirty data of ours sharing a line
+	with it would be lost.
+ */
+static inline void IPCInvalidateRange(const volatile void* p, uint32_t len)
+{
+	#if (defined(__aarch64__) || defined(HAVE_L1)) && !defined(IPC_HOST_SIMULATION)
+		if(len == 0)
+			return;
+
+		uintptr_t start = reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(IPC_LOCAL_CACHE_LINE_SIZE - 1);
+		uintptr_t end = reinterpret_cast<uintptr_t>(p) + len;
+
+		asm volatile("dsb sy" ::: "memory");
+		for(uintptr_t addr = start; addr < end; addr += IPC_LOCAL_CACHE_LINE_SIZE)
+		{
+			#ifdef __aarch64__
+				asm volatile("dc ivac, %0" :: "r"(addr) : "memory");
+			#else
+				*SCB_DCIMVAC = addr;
+			#endif
+		}
+		asm volatile("dsb sy" ::: "memory");
+	#else
+		(void)p;
+		(void)len;
+	#endif
+}
+
+#endif
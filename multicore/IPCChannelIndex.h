@@ -0,0 +1,139 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef IPCChannelIndex_h
+#define IPCChannelIndex_h
+
+#include <stdint.h>
+
+/**
+	@brief Computes the ID of an IPC channel from its name (32-bit FNV-1a)
+
+	constexpr, so callers on the secondary side can resolve channels with no string handling at all:
+
+	auto chan = g_ipcDescriptorTable.FindChannel(IPCChannelID("log"));
+ */
+constexpr uint32_t IPCChannelID(const char* name)
+{
+	uint32_t hash = 0x811c9dc5;
+	for(; *name; name++)
+		hash = (hash ^ static_cast<uint8_t>(*name)) * 0x01000193;
+	return hash;
+}
+
+/**
+	@brief Picks a hash index size for a given number of channels (next power of two at least twice as big)
+ */
+constexpr uint32_t IPCChannelIndexSize(uint32_t channels)
+{
+	uint32_t size = 1;
+	while(size < 2*channels)
+		size <<= 1;
+	return size;
+}
+
+/**
+	@brief Open-addressed hash index from channel ID to channel slot, stored in the shared descriptor table
+
+	Written by the primary as channels are allocated, read-only on the secondary. Uses uint32_t fields only so the
+	layout is identical on armv8-m and aarch64.
+ */
+template<uint32_t size>
+class IPCChannelIndex
+{
+public:
+	static_assert( (size & (size - 1)) == 0, "IPC channel index size must be a power of two");
+
+	///@brief Empties the index
+	void Clear()
+	{
+		for(uint32_t i=0; i<size; i++)
+		{
+			m_ids[i] = 0;
+			m_slots[i] = 0;
+		}
+	}
+
+	/**
+		@brief Adds a channel to the index
+
+		@return False if the ID is already in use, or the index is full
+	 */
+	bool Insert(uint32_t id, uint32_t slot)
+	{
+		for(uint32_t i=0; i<size; i++)
+		{
+			uint32_t pos = (id + i) & (size - 1);
+
+			if(m_slots[pos] == 0)
+			{
+				m_ids[pos] = id;
+				m_slots[pos] = slot + 1;
+				return true;
+			}
+
+			if(m_ids[pos] == id)
+				return false;
+		}
+
+		return false;
+	}
+
+	/**
+		@brief Looks up a channel by ID
+
+		@return The channel slot, or -1 if not found
+	 */
+	int32_t Lookup(uint32_t id)
+	{
+		for(uint32_t i=0; i<size; i++)
+		{
+			uint32_t pos = (id + i) & (size - 1);
+
+			//Empty slot terminates the probe sequence
+			if(m_slots[pos] == 0)
+				return -1;
+
+			if(m_ids[pos] == id)
+				return m_slots[pos] - 1;
+		}
+
+		return -1;
+	}
+
+protected:
+
+	///@brief Channel ID in each bucket
+	volatile uint32_t m_ids[size];
+
+	///@brief Channel slot plus one in each bucket (0 = empty)
+	volatile uint32_t m_slots[size];
+};
+
+#endif
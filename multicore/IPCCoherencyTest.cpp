@@ -0,0 +1,206 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include "IPCCoherencyTest.h"
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Test pattern
+
+/**
+	@brief Gets the length of a test message (at least 4 bytes, for the sequence number)
+ */
+static uint32_t GetTestLength(uint32_t seq, uint32_t maxlen)
+{
+	uint32_t x = seq * 2654435761U;
+	return 4 + (x >> 8) % (maxlen - 3);
+}
+
+static uint8_t GetTestByte(uint32_t seq, uint32_t i)
+{
+	return (seq * 31 + i * 7) ^ (i >> 5) ^ (seq >> 8);
+}
+
+static void FillTestMessage(uint8_t* buf, uint32_t seq, uint32_t len)
+{
+	memcpy(buf, &seq, sizeof(seq));
+	for(uint32_t i=4; i<len; i++)
+		buf[i] = GetTestByte(seq, i);
+}
+
+/**
+	@brief Checks a received test message
+
+	@return Number of bad bytes (or 1 for a wrong length/sequence number)
+ */
+static uint32_t CheckTestMessage(const uint8_t* buf, uint32_t len, uint32_t expectedSeq, uint32_t maxlen)
+{
+	uint32_t seq;
+	memcpy(&seq, buf, sizeof(seq));
+	if(seq != expectedSeq)
+	{
+		g_log(Logger::ERROR, "IPC coherency: expected message %u, got %u\n", expectedSeq, seq);
+		return 1;
+	}
+
+	uint32_t expectedLen = GetTestLength(seq, maxlen);
+	if(len != expectedLen)
+	{
+		g_log(Logger::ERROR, "IPC coherency: message %u is %u bytes, expected %u\n", seq, len, expectedLen);
+		return 1;
+	}
+
+	uint32_t errors = 0;
+	for(uint32_t i=4; i<len; i++)
+	{
+		if(buf[i] != GetTestByte(seq, i))
+		{
+			if(errors == 0)
+			{
+				g_log(Logger::ERROR, "IPC coherency: message %u byte %u is %02x, expected %02x\n",
+					seq, i, buf[i], GetTestByte(seq, i));
+			}
+			errors ++;
+		}
+	}
+	return errors;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FIFO
+
+/**
+	@brief Sends count test messages through a FIFO
+ */
+void IPCCoherencyTestSend(UnidirectionalIPCFifo* fifo, uint32_t count)
+{
+	static uint8_t buf[1024];
+	uint32_t maxlen = fifo->size();
+	if(maxlen > sizeof(buf))
+		maxlen = sizeof(buf);
+
+	for(uint32_t seq=0; seq<count; seq++)
+	{
+		uint32_t len = GetTestLength(seq, maxlen);
+		FillTestMessage(buf, seq, len);
+		fifo->Push(buf, len);
+	}
+}
+
+/**
+	@brief Receives and checks count test messages from a FIFO
+
+	@param scratch	Buffer at least as big as the FIFO
+
+	@return Number of errors
+ */
+uint32_t IPCCoherencyTestReceive(UnidirectionalIPCFifo* fifo, uint8_t* scratch, uint32_t count)
+{
+	//Must match the sender's idea of the max length
+	uint32_t maxlen = fifo->size();
+	if(maxlen > 1024)
+		maxlen = 1024;
+
+	uint32_t errors = 0;
+	for(uint32_t seq=0; seq<count; )
+	{
+		uint32_t len = fifo->Pop(scratch);
+		if(len == 0)
+		{
+			IPCSpinWait();
+			continue;
+		}
+
+		errors += CheckTestMessage(scratch, len, seq, maxlen);
+		seq ++;
+	}
+
+	g_log("IPC coherency test (FIFO): %u messages, %u errors\n", count, errors);
+	return errors;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Ring buffer
+
+/**
+	@brief Sends count test messages through a ring buffer
+ */
+void IPCCoherencyTestSend(IPCRingBuffer* ring, uint32_t count)
+{
+	uint32_t maxlen = ring->size() / 2 - 8;
+
+	for(uint32_t seq=0; seq<count; seq++)
+	{
+		uint32_t len = GetTestLength(seq, maxlen);
+
+		uint8_t* buf;
+		while( (buf = ring->Reserve(len)) == nullptr)
+			IPCSpinWait();
+
+		FillTestMessage(buf, seq, len);
+		ring->Commit(len);
+	}
+}
+
+/**
+	@brief Receives and checks count test messages from a ring buffer
+
+	@return Number of errors
+ */
+uint32_t IPCCoherencyTestReceive(IPCRingBuffer* ring, uint32_t count)
+{
+	uint32_t maxlen = ring->size() / 2 - 8;
+
+	uint32_t errors = 0;
+	for(uint32_t seq=0; seq<count; )
+	{
+		ring->AcknowledgeDoorbell();
+
+		uint32_t len;
+		auto buf = ring->Peek(len);
+		if(!buf)
+		{
+			IPCSpinWait();
+			continue;
+		}
+
+		errors += CheckTestMessage(buf, len, seq, maxlen);
+		ring->Release();
+		seq ++;
+	}
+
+	g_log("IPC coherency test (ring): %u messages, %u errors\n", count, errors);
+	return errors;
+}
+
+#endif
+#endif
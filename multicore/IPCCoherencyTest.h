@@ -0,0 +1,59 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef IPCCoherencyTest_h
+#define IPCCoherencyTest_h
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+
+#include "IPCDescriptorTable.h"
+
+/**
+	@file
+	@brief Stress test for IPC cache maintenance
+
+	One side runs a Send function and the other side the matching Receive function on the same channel. Messages of
+	pseudorandom length (so they start and end at every offset within a cache line, and wrap around ring buffers at
+	every position) carry a sequence number and a pattern derived from it. The receiver checks every byte, so a
+	missing clean on the sending side or a missing invalidate on the receiving side shows up as stale data.
+
+	Run it with the IPC buffers in cacheable memory.
+ */
+
+void IPCCoherencyTestSend(UnidirectionalIPCFifo* fifo, uint32_t count);
+uint32_t IPCCoherencyTestReceive(UnidirectionalIPCFifo* fifo, uint8_t* scratch, uint32_t count);
+
+void IPCCoherencyTestSend(IPCRingBuffer* ring, uint32_t count);
+uint32_t IPCCoherencyTestReceive(IPCRingBuffer* ring, uint32_t count);
+
+#endif
+#endif
+
+#endif
@@ -44,6 +44,11 @@ IPCDescriptorTable::IPCDescriptorTable(volatile ipcc_t* ipcc)
 {
 	#ifdef PRIMARY_CORE
 		m_firstFreeChannel = 0;
+		m_firstFreeRingChannel = 0;
+		m_channelIndex.Clear();
+		#if NUM_IPC_RING_CHANNELS > 0
+			m_ringChannelIndex.Clear();
+		#endif
 
 		m_ipcc.Initialize();
 	#endif
@@ -56,6 +61,9 @@ IPCDescriptorTable::IPCDescriptorTable(volatile ipcc_t* ipcc)
 
 	The name and buffers are stored in the channel without copying and must remain available for the
 	lifetime of the object.
+
+	Fails if another channel has the same name, or a name with the same hash, or if either buffer doesn't start and end
+	on an IPC_CACHE_LINE_SIZE boundary (see IPCCache.h).
  */
 IPCDescriptorChannel* IPCDescriptorTable::AllocateChannel(
 	const char* name,
@@ -67,9 +75,21 @@ IPCDescriptorChannel* IPCDescriptorTable::AllocateChannel(
 	if(m_firstFreeChannel >= NUM_IPC_CHANNELS)
 		return nullptr;
 
+	//Invalidating a partial line on receive would throw away whatever else shares it
+	if(!IsIPCCacheAligned(txbuf, txsize) || !IsIPCCacheAligned(rxbuf, rxsize))
+	{
+		g_log(Logger::ERROR, "IPC channel \"%s\" buffers are not whole cache lines\n", name);
+		return nullptr;
+	}
+
 	//Get the newly allocated block
 	auto idx = m_firstFreeChannel;
 	auto chan = &m_channels[idx];
+	if(!m_channelIndex.Insert(IPCChannelID(name), idx))
+	{
+		g_log(Logger::ERROR, "IPC channel ID for \"%s\" is already in use\n", name);
+		return nullptr;
+	}
 	m_firstFreeChannel = idx + 1;	//gcc complains if we ++ a volatile
 									//(even though only primary side can write to it)
 
@@ -78,30 +98,114 @@ IPCDescriptorChannel* IPCDescriptorTable::AllocateChannel(
 	chan->GetPrimaryFifo().Initialize(txbuf, txsize, idx, &m_ipcc, true);
 	chan->GetSecondaryFifo().Initialize(rxbuf, rxsize, idx, &m_ipcc, false);
 
+	//Make sure the secondary sees the new descriptor even if the table is in cacheable memory
+	IPCCleanRange(this, sizeof(*this));
+
 	//Done
 	return chan;
 }
-#else
 
-IPCDescriptorChannel* IPCDescriptorTable::FindChannel(const char* name)
+#if NUM_IPC_RING_CHANNELS > 0
+/**
+	@brief Allocate a new ring buffer IPC channel with a given name and buffers
+
+	The name and buffers are stored in the channel without copying and must remain available for the
+	lifetime of the object. Buffer sizes must be powers of two.
+
+	Fails if another ring channel has the same name, or a name with the same hash, or if either buffer doesn't start
+	and end on an IPC_CACHE_LINE_SIZE boundary (see IPCCache.h).
+ */
+IPCRingChannel* IPCDescriptorTable::AllocateRingChannel(
+	const char* name,
+	volatile uint8_t* txbuf, uint32_t txsize,
+	volatile uint8_t* rxbuf, uint32_t rxsize
+	)
 {
-	for(uint32_t i=0; i<NUM_IPC_CHANNELS; i++)
-	{
-		auto chan = &m_channels[i];
+	//Make sure we have channels to allocate
+	if(m_firstFreeRingChannel >= NUM_IPC_RING_CHANNELS)
+		return nullptr;
 
-		//Unallocated? Skip it
-		auto cname = chan->GetName();
-		if(cname == nullptr)
-			continue;
+	//Invalidating a partial line on receive would throw away whatever else shares it
+	if(!IsIPCCacheAligned(txbuf, txsize) || !IsIPCCacheAligned(rxbuf, rxsize))
+	{
+		g_log(Logger::ERROR, "IPC ring channel \"%s\" buffers are not whole cache lines\n", name);
+		return nullptr;
+	}
 
-		//Check name
-		if(!strcmp(cname, name))
-			return chan;
+	//Get the newly allocated block
+	auto idx = m_firstFreeRingChannel;
+	auto chan = &m_ringChannels[idx];
+	if(!m_ringChannelIndex.Insert(IPCChannelID(name), idx))
+	{
+		g_log(Logger::ERROR, "IPC ring channel ID for \"%s\" is already in use\n", name);
+		return nullptr;
 	}
+	m_firstFreeRingChannel = idx + 1;
+
+	//Initialize it
+	chan->SetName(name);
+	chan->GetPrimaryRing().Initialize(txbuf, txsize, NUM_IPC_CHANNELS + idx, &m_ipcc, true);
+	chan->GetSecondaryRing().Initialize(rxbuf, rxsize, NUM_IPC_CHANNELS + idx, &m_ipcc, false);
+
+	//Make sure the secondary sees the new descriptor even if the table is in cacheable memory
+	IPCCleanRange(this, sizeof(*this));
+
+	//Done
+	return chan;
+}
+#endif
+
+#else
+
+/**
+	@brief Looks up a channel by name
+
+	The name is hashed and looked up by ID, then checked against the channel's actual name in case it's a different
+	channel with a colliding hash.
+ */
+IPCDescriptorChannel* IPCDescriptorTable::FindChannel(const char* name)
+{
+	auto chan = FindChannel(IPCChannelID(name));
+	if(chan && !strcmp(chan->GetName(), name))
+		return chan;
+	return nullptr;
+}
 
+/**
+	@brief Looks up a channel by ID (see IPCChannelID())
+ */
+IPCDescriptorChannel* IPCDescriptorTable::FindChannel(uint32_t id)
+{
+	auto idx = m_channelIndex.Lookup(id);
+	if( (idx < 0) || (idx >= NUM_IPC_CHANNELS) )
+		return nullptr;
+	return &m_channels[idx];
+}
+
+#if NUM_IPC_RING_CHANNELS > 0
+/**
+	@brief Looks up a ring channel by name
+ */
+IPCRingChannel* IPCDescriptorTable::FindRingChannel(const char* name)
+{
+	auto chan = FindRingChannel(IPCChannelID(name));
+	if(chan && !strcmp(chan->GetName(), name))
+		return chan;
 	return nullptr;
 }
 
+/**
+	@brief Looks up a ring channel by ID (see IPCChannelID())
+ */
+IPCRingChannel* IPCDescriptorTable::FindRingChannel(uint32_t id)
+{
+	auto idx = m_ringChannelIndex.Lookup(id);
+	if( (idx < 0) || (idx >= NUM_IPC_RING_CHANNELS) )
+		return nullptr;
+	return &m_ringChannels[idx];
+}
+#endif
+
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -119,22 +223,37 @@ UnidirectionalIPCFifo::UnidirectionalIPCFifo()
 	#endif
 }
 
+/**
+	@brief Pushes a message, busy-waiting until the peer has drained the previous one
+
+	Messages larger than the FIFO are silently discarded. Use TryPush() (or IPCAsyncSender) from code that can't
+	afford to stall.
+ */
 void UnidirectionalIPCFifo::Push(const uint8_t* buf, uint32_t size)
+{
+	while(TryPush(buf, size) == IPC_PUSH_WOULD_BLOCK)
+		IPCSpinWait();
+}
+
+/**
+	@brief Pushes a message if the FIFO is free, without waiting
+ */
+IPCPushResult UnidirectionalIPCFifo::TryPush(const uint8_t* buf, uint32_t size)
 {
 	//early out if buffer is too big
 	if(size > m_size)
-		return;
+		return IPC_PUSH_TOO_BIG;
 
-	//Wait until the IPC channel is free
+	//Make sure the IPC channel is free
 	if(m_primaryTx)
 	{
-		while(!m_ipcc->IsPrimaryToSecondaryChannelFree(m_clearmask))
-		{}
+		if(!m_ipcc->IsPrimaryToSecondaryChannelFree(m_clearmask))
+			return IPC_PUSH_WOULD_BLOCK;
 	}
 	else
 	{
-		while(!m_ipcc->IsSecondaryToPrimaryChannelFree(m_clearmask))
-		{}
+		if(!m_ipcc->IsSecondaryToPrimaryChannelFree(m_clearmask))
+			return IPC_PUSH_WOULD_BLOCK;
 	}
 
 	//Write it
@@ -142,9 +261,10 @@ void UnidirectionalIPCFifo::Push(const uint8_t* buf, uint32_t size)
 	memcpy(wbuf, buf, size);
 	m_writePtr = size;
 
-	//Cache flush
-	CleanDataCache(wbuf, size);
-	CleanDataCache((void*)&m_writePtr, sizeof(m_writePtr));
+	//Write back just the lines we touched (this waits for completion, so the data is visible before the doorbell)
+	IPCCleanRange(wbuf, size);
+	IPCCleanRange(&m_writePtr, sizeof(m_writePtr));
+	IPCMemoryBarrier();
 
 	//Mark it as busy
 	if(m_primaryTx)
@@ -152,8 +272,7 @@ void UnidirectionalIPCFifo::Push(const uint8_t* buf, uint32_t size)
 	else
 		m_ipcc->SetSecondaryToPrimaryChannelBusy(m_setmask);
 
-	//TODO: cache flush
-	asm("dmb st");
+	return IPC_PUSH_OK;
 }
 
 bool UnidirectionalIPCFifo::Peek()
@@ -175,10 +294,18 @@ uint32_t UnidirectionalIPCFifo::Pop(uint8_t* rxbuf)
 	if(!Peek())
 		return 0;
 
+	//Drop any stale copies of the length and data from a previous message before reading them
+	IPCInvalidateRange(&m_writePtr, sizeof(m_writePtr));
 	uint32_t p = m_writePtr;
+	if(p > m_size)
+		p = m_size;
+
+	auto rbuf = m_buffer.Get();
+	IPCInvalidateRange(rbuf, p);
+	memcpy(rxbuf, const_cast<uint8_t*>(rbuf), p);
 
-	memcpy(rxbuf, const_cast<uint8_t*>(m_buffer.Get()), p);
-	asm("dmb st");
+	//Finish reading before handing the buffer back
+	IPCMemoryBarrier();
 
 	if(m_primaryTx)
 		m_ipcc->SetPrimaryToSecondaryChannelFree(m_clearmask);
@@ -198,6 +325,16 @@ IPCDescriptorChannel::IPCDescriptorChannel()
 	#endif
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IPCRingChannel
+
+IPCRingChannel::IPCRingChannel()
+{
+	#ifdef PRIMARY_CORE
+		m_name.Set(nullptr);
+	#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Debug logging
 
@@ -213,6 +350,19 @@ void IPCDescriptorChannel::Print(unsigned int idx)
 		m_secondaryTxFifo.size()
 		);}
 
+void IPCRingChannel::Print(unsigned int idx)
+{
+	const char* name = GetName();
+	g_log("%2u | %-15s | " PTR_FMT " | %8u | " PTR_FMT " | %8u\n",
+		idx,
+		name ? name : "(null)",
+		PTR_ARGS(m_primaryTxRing.GetBuffer()),
+		m_primaryTxRing.size(),
+		PTR_ARGS(m_secondaryTxRing.GetBuffer()),
+		m_secondaryTxRing.size()
+		);
+}
+
 void IPCDescriptorTable::Print()
 {
 	g_log("Dumping IPC descriptor table (%d secondary cores, %d channels)\n", NUM_SECONDARY_CORES, NUM_IPC_CHANNELS);
@@ -223,4 +373,10 @@ void IPCDescriptorTable::Print()
 
 	for(size_t i=0; i<NUM_IPC_CHANNELS; i++)
 		m_channels[i].Print(i);
+
+	#if NUM_IPC_RING_CHANNELS > 0
+		g_log("Ring channels:\n");
+		for(size_t i=0; i<NUM_IPC_RING_CHANNELS; i++)
+			m_ringChannels[i].Print(i);
+	#endif
 }
@@ -34,6 +34,32 @@
 #ifdef HAVE_IPCC
 
 #include <peripheral/IPCC.h>
+#include "IPCRingBuffer.h"
+#include "IPCChannelIndex.h"
+#include "IPCCache.h"
+
+#ifndef NUM_IPC_RING_CHANNELS
+#define NUM_IPC_RING_CHANNELS 0
+#endif
+
+///@brief Number of channels per direction in the IPCC
+#ifndef NUM_IPCC_CHANNELS
+#define NUM_IPCC_CHANNELS 16
+#endif
+
+//FIFO channel i uses IPCC channel i and ring channel i uses NUM_IPC_CHANNELS + i, with the set mask in the upper half
+//of a 32-bit word, so they all have to fit in 16 IPCC channels
+static_assert(NUM_IPCC_CHANNELS <= 16, "IPCC channel masks only have room for 16 channels");
+static_assert( (NUM_IPC_CHANNELS + NUM_IPC_RING_CHANNELS) <= NUM_IPCC_CHANNELS,
+	"NUM_IPC_CHANNELS + NUM_IPC_RING_CHANNELS must not exceed the number of IPCC channels");
+
+///@brief Result of a non-blocking push
+enum IPCPushResult
+{
+	IPC_PUSH_OK,			//message was sent
+	IPC_PUSH_WOULD_BLOCK,	//peer hasn't drained the previous message yet, try again later
+	IPC_PUSH_TOO_BIG		//message is larger than the FIFO and can never be sent
+};
 
 /**
 	@brief Buffers and pointers for a unidirectional FIFO
@@ -71,7 +97,12 @@ public:
 	uint32_t WriteSize()
 	{ return m_size - m_writePtr; }
 
+	///@brief Gets the IPCC channel number used for this FIFO's doorbell
+	uint32_t GetChannel()
+	{ return __builtin_ctz(m_clearmask); }
+
 	void Push(const uint8_t* buf, uint32_t size);
+	IPCPushResult TryPush(const uint8_t* buf, uint32_t size);
 	uint32_t Pop(uint8_t* rxbuf);
 
 	bool Peek();
@@ -115,11 +146,18 @@ public:
 	{ return m_secondaryTxFifo; }
 
 	void SetName(const char* ptr)
-	{ m_name.Set(ptr); }
+	{
+		m_name.Set(ptr);
+		m_id = IPCChannelID(ptr);
+	}
 
 	const char* GetName()
 	{ return const_cast<const char*>(m_name.Get()); }
 
+	///@brief Gets the hashed ID of the channel name
+	uint32_t GetID()
+	{ return m_id; }
+
 	void Print(unsigned int idx);
 
 protected:
@@ -127,11 +165,62 @@ protected:
 	///@brief Name of the channel
 	PaddedPointer<const char> m_name __attribute__((aligned(8)));
 
+	///@brief Hash of the name
+	uint32_t m_id __attribute__((aligned(8)));
+
+	//Each FIFO is written by a different side, so they must not share a cache line
+
 	///@brief FIFO from primary to secondary
-	UnidirectionalIPCFifo m_primaryTxFifo __attribute__((aligned(8)));
+	UnidirectionalIPCFifo m_primaryTxFifo __attribute__((aligned(IPC_CACHE_LINE_SIZE)));
 
 	///@brief FIFO from secondary to primary
-	UnidirectionalIPCFifo m_secondaryTxFifo __attribute__((aligned(8)));
+	UnidirectionalIPCFifo m_secondaryTxFifo __attribute__((aligned(IPC_CACHE_LINE_SIZE)));
+};
+
+/**
+	@brief A single ring buffer channel within the IPC descriptor table
+
+	Uses IPCC channel NUM_IPC_CHANNELS + index, so ring channels don't share doorbells with FIFO channels.
+ */
+class IPCRingChannel
+{
+public:
+	IPCRingChannel();
+
+	IPCRingBuffer& GetPrimaryRing()
+	{ return m_primaryTxRing; }
+
+	IPCRingBuffer& GetSecondaryRing()
+	{ return m_secondaryTxRing; }
+
+	void SetName(const char* ptr)
+	{
+		m_name.Set(ptr);
+		m_id = IPCChannelID(ptr);
+	}
+
+	const char* GetName()
+	{ return const_cast<const char*>(m_name.Get()); }
+
+	///@brief Gets the hashed ID of the channel name
+	uint32_t GetID()
+	{ return m_id; }
+
+	void Print(unsigned int idx);
+
+protected:
+
+	///@brief Name of the channel
+	PaddedPointer<const char> m_name __attribute__((aligned(8)));
+
+	///@brief Hash of the name
+	uint32_t m_id __attribute__((aligned(8)));
+
+	///@brief Ring from primary to secondary
+	IPCRingBuffer m_primaryTxRing;
+
+	///@brief Ring from secondary to primary
+	IPCRingBuffer m_secondaryTxRing;
 };
 
 /**
@@ -154,23 +243,54 @@ public:
 		volatile uint8_t* txbuf, uint32_t txsize,
 		volatile uint8_t* rxbuf, uint32_t rxsize
 		);
+	#if NUM_IPC_RING_CHANNELS > 0
+	IPCRingChannel* AllocateRingChannel(
+		const char* name,
+		volatile uint8_t* txbuf, uint32_t txsize,
+		volatile uint8_t* rxbuf, uint32_t rxsize
+		);
+	#endif
 	#else
 	IPCDescriptorChannel* FindChannel(const char* name);
+	IPCDescriptorChannel* FindChannel(uint32_t id);
+	#if NUM_IPC_RING_CHANNELS > 0
+	IPCRingChannel* FindRingChannel(const char* name);
+	IPCRingChannel* FindRingChannel(uint32_t id);
+	#endif
 	#endif
 
 	IPCDescriptorChannel* GetChannelByIndex(uint32_t i)
 	{ return &m_channels[i]; }
 
+	#if NUM_IPC_RING_CHANNELS > 0
+	IPCRingChannel* GetRingChannelByIndex(uint32_t i)
+	{ return &m_ringChannels[i]; }
+	#endif
+
 protected:
 
 	///@brief The actual IPC channel data descriptors
 	IPCDescriptorChannel m_channels[NUM_IPC_CHANNELS];
 
+	///@brief Hash index of m_channels by channel ID
+	IPCChannelIndex<IPCChannelIndexSize(NUM_IPC_CHANNELS)> m_channelIndex;
+
+	#if NUM_IPC_RING_CHANNELS > 0
+	///@brief Ring buffer channel descriptors
+	IPCRingChannel m_ringChannels[NUM_IPC_RING_CHANNELS];
+
+	///@brief Hash index of m_ringChannels by channel ID
+	IPCChannelIndex<IPCChannelIndexSize(NUM_IPC_RING_CHANNELS)> m_ringChannelIndex;
+	#endif
+
 	///@brief The IPCC channel we're using
 	IPCC m_ipcc;
 
 	///@brief Index of the first free channel
 	uint32_t m_firstFreeChannel __attribute__((aligned(8)));
+
+	///@brief Index of the first free ring channel
+	uint32_t m_firstFreeRingChannel;
 };
 
 extern "C" IPCDescriptorTable g_ipcDescriptorTable;
@@ -0,0 +1,182 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include "IPCInterruptDispatcher.h"
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+
+/**
+	@file
+	@brief Implementation of IPCInterruptDispatcher
+
+	The primary core is IPCC processor 1 and the secondary is processor 2 (primary-to-secondary channels are set by
+	processor 1), so each side uses its own control and mask registers and the other side's status register.
+ */
+
+#ifdef PRIMARY_CORE
+	#define IPCC_CR			C1CR
+	#define IPCC_MR			C1MR
+	#define IPCC_TXSR		C1TOC2SR
+	#define IPCC_RXSR		C2TOC1SR
+#else
+	#define IPCC_CR			C2CR
+	#define IPCC_MR			C2MR
+	#define IPCC_TXSR		C2TOC1SR
+	#define IPCC_RXSR		C1TOC2SR
+#endif
+
+//CxCR bits
+#define IPCC_CR_RXOIE		0x00000001
+#define IPCC_CR_TXFIE		0x00010000
+
+//all CxMR bits are masks: occupied in the low half, free in the high half
+#define IPCC_MR_ALL			0xffffffff
+
+#ifdef HAVE_IPCC_IRQ
+///@brief Interrupt dispatcher for the IPCC used by g_ipcDescriptorTable
+IPCInterruptDispatcher g_ipcInterruptDispatcher(&IPCC1);
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction / destruction
+
+IPCInterruptDispatcher::IPCInterruptDispatcher(volatile ipcc_t* ipcc)
+	: m_ipcc(ipcc)
+	, m_rxReady(0)
+	, m_txReady(0)
+{
+	for(uint32_t i=0; i<NUM_IPCC_CHANNELS; i++)
+	{
+		m_rxTasks[i] = nullptr;
+		m_txTasks[i] = nullptr;
+	}
+}
+
+/**
+	@brief Masks every channel, then turns on the RX occupied and TX free interrupts
+
+	Channels are individually unmasked as receivers are registered and senders are armed.
+ */
+void IPCInterruptDispatcher::Initialize()
+{
+	m_ipcc->IPCC_MR = IPCC_MR_ALL;
+	m_ipcc->IPCC_CR = IPCC_CR_RXOIE | IPCC_CR_TXFIE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Registration
+
+/**
+	@brief Sets the task to wake when a channel receives data, and unmasks its RX interrupt
+ */
+void IPCInterruptDispatcher::RegisterReceiver(uint32_t channel, Task* task)
+{
+	if(channel >= NUM_IPCC_CHANNELS)
+		return;
+
+	m_rxTasks[channel] = task;
+	ArmRx(channel);
+}
+
+/**
+	@brief Re-enables the RX interrupt for a channel
+
+	Call once the received message has been consumed and the channel freed. If the peer has already sent another
+	message the interrupt fires again right away.
+ */
+void IPCInterruptDispatcher::ArmRx(uint32_t channel)
+{
+	//The ISRs modify the mask register too
+	InterruptGuard guard;
+	m_ipcc->IPCC_MR &= ~(1 << channel);
+}
+
+/**
+	@brief Requests a wakeup when a channel becomes free to transmit
+
+	If the channel is already free the interrupt fires right away, so there's no race with the peer freeing it
+	between a failed push and this call.
+ */
+void IPCInterruptDispatcher::ArmTx(uint32_t channel, Task* task)
+{
+	if(channel >= NUM_IPCC_CHANNELS)
+		return;
+
+	m_txTasks[channel] = task;
+
+	InterruptGuard guard;
+	m_ipcc->IPCC_MR &= ~(1 << (16 + channel));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Interrupt handlers
+
+/**
+	@brief Handles the IPCC RX occupied interrupt (call from the BSP's ISR)
+ */
+void IPCInterruptDispatcher::OnRxInterrupt()
+{
+	//Find occupied channels we haven't already reported
+	uint32_t pending = m_ipcc->IPCC_RXSR & ~m_ipcc->IPCC_MR & 0xffff;
+
+	//Mask them so the interrupt deasserts while the receiver gets around to it
+	m_ipcc->IPCC_MR |= pending;
+	__atomic_fetch_or(&m_rxReady, pending, __ATOMIC_ACQ_REL);
+
+	for(uint32_t i=0; pending; i++, pending >>= 1)
+	{
+		if( (pending & 1) && m_rxTasks[i])
+			m_rxTasks[i]->Wake();
+	}
+}
+
+/**
+	@brief Handles the IPCC TX free interrupt (call from the BSP's ISR)
+ */
+void IPCInterruptDispatcher::OnTxInterrupt()
+{
+	//Find free channels that somebody is waiting on
+	uint32_t armed = ~(m_ipcc->IPCC_MR >> 16) & 0xffff;
+	uint32_t pending = ~m_ipcc->IPCC_TXSR & armed;
+
+	//TX free is a one-shot request, mask it until the next ArmTx()
+	m_ipcc->IPCC_MR |= (pending << 16);
+	__atomic_fetch_or(&m_txReady, pending, __ATOMIC_ACQ_REL);
+
+	for(uint32_t i=0; pending; i++, pending >>= 1)
+	{
+		if( (pending & 1) && m_txTasks[i])
+			m_txTasks[i]->Wake();
+	}
+}
+
+#endif
+#endif
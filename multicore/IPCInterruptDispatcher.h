@@ -0,0 +1,118 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef IPCInterruptDispatcher_h
+#define IPCInterruptDispatcher_h
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+
+#include <peripheral/IPCC.h>
+
+#ifndef NUM_IPCC_CHANNELS
+#define NUM_IPCC_CHANNELS 16
+#endif
+
+class Task;
+
+/**
+	@brief Turns IPCC "RX occupied" and "TX free" interrupts into task wakeups
+
+	Instead of polling each channel's status register every pass through the main loop, a receiver task registers
+	with RegisterReceiver() and is woken when the peer sends it something, and a sender that got IPC_PUSH_WOULD_BLOCK
+	calls ArmTx() and is woken when the peer has drained the channel.
+
+	IPCC interrupts are level sensitive (RX stays asserted while a channel is occupied, TX while it's free), so the ISR
+	masks each channel it reports. Receivers call ArmRx() once they've freed the channel to get the next one.
+
+	The BSP is responsible for enabling the IPCC RX and TX interrupts in the NVIC/GIC and calling OnRxInterrupt() and
+	OnTxInterrupt() from the handlers. None of the BSPs in this repo do that yet, so g_ipcInterruptDispatcher only
+	exists if the build defines HAVE_IPCC_IRQ to say the handlers are wired up. Without them, tasks relying on the
+	dispatcher would never be woken.
+
+	Lives in core-local memory, not the shared descriptor table: each side of the link has its own dispatcher.
+ */
+class IPCInterruptDispatcher
+{
+public:
+	IPCInterruptDispatcher(volatile ipcc_t* ipcc);
+
+	void Initialize();
+
+	void RegisterReceiver(uint32_t channel, Task* task);
+	void ArmRx(uint32_t channel);
+	void ArmTx(uint32_t channel, Task* task);
+
+	/**
+		@brief Checks if a channel has had an RX interrupt since the last call, and clears the flag if so
+	 */
+	bool ConsumeRxReady(uint32_t channel)
+	{
+		uint32_t mask = 1 << channel;
+		return (__atomic_fetch_and(&m_rxReady, ~mask, __ATOMIC_ACQ_REL) & mask) != 0;
+	}
+
+	/**
+		@brief Checks if a channel has had a TX free interrupt since it was armed, and clears the flag if so
+	 */
+	bool ConsumeTxReady(uint32_t channel)
+	{
+		uint32_t mask = 1 << channel;
+		return (__atomic_fetch_and(&m_txReady, ~mask, __ATOMIC_ACQ_REL) & mask) != 0;
+	}
+
+	void OnRxInterrupt();
+	void OnTxInterrupt();
+
+protected:
+
+	///@brief The IPC controller
+	volatile ipcc_t* m_ipcc;
+
+	///@brief Tasks to wake when each channel receives data
+	Task* m_rxTasks[NUM_IPCC_CHANNELS];
+
+	///@brief Tasks to wake when each channel becomes free to transmit
+	Task* m_txTasks[NUM_IPCC_CHANNELS];
+
+	///@brief Channels with an unacknowledged RX interrupt
+	uint32_t m_rxReady;
+
+	///@brief Channels with an unacknowledged TX free interrupt
+	uint32_t m_txReady;
+};
+
+#ifdef HAVE_IPCC_IRQ
+extern IPCInterruptDispatcher g_ipcInterruptDispatcher;
+#endif
+
+#endif
+#endif
+
+#endif
@@ -0,0 +1,298 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include "IPCRPC.h"
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+#if NUM_IPC_RING_CHANNELS > 0
+
+/**
+	@file
+	@brief Implementation of IPCRPCEndpoint, IPCRPCClient, and IPCRPCServer
+ */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IPCRPCEndpoint
+
+IPCRPCEndpoint::IPCRPCEndpoint()
+	: m_tx(nullptr)
+	, m_rx(nullptr)
+	, m_dispatcher(nullptr)
+{
+}
+
+/**
+	@brief Attaches to a ring channel
+
+	The primary core sends on the channel's primary ring and the secondary on its secondary ring, so the same call
+	works for either side.
+ */
+void IPCRPCEndpoint::SetChannel(IPCRingChannel* channel)
+{
+	#ifdef PRIMARY_CORE
+		m_tx = &channel->GetPrimaryRing();
+		m_rx = &channel->GetSecondaryRing();
+	#else
+		m_tx = &channel->GetSecondaryRing();
+		m_rx = &channel->GetPrimaryRing();
+	#endif
+}
+
+/**
+	@brief Use RX interrupts, rather than polling every pass through the main loop, to find out about new messages
+
+	Must be called after SetChannel().
+ */
+void IPCRPCEndpoint::SetInterruptDispatcher(IPCInterruptDispatcher* dispatcher)
+{
+	m_dispatcher = dispatcher;
+	SetAlwaysReady(false);
+	dispatcher->RegisterReceiver(m_rx->GetChannel(), this);
+}
+
+/**
+	@brief Acknowledges any doorbell before draining the receive ring
+ */
+void IPCRPCEndpoint::BeginPoll()
+{
+	if(m_dispatcher)
+		m_dispatcher->ConsumeRxReady(m_rx->GetChannel());
+	m_rx->AcknowledgeDoorbell();
+}
+
+/**
+	@brief Re-enables the doorbell interrupt once the receive ring has been drained
+ */
+void IPCRPCEndpoint::EndPoll()
+{
+	if(m_dispatcher)
+		m_dispatcher->ArmRx(m_rx->GetChannel());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IPCRPCClient
+
+IPCRPCClient::IPCRPCClient()
+	: m_pendingCount(0)
+	, m_nextSeq(1)
+	, m_orphans(0)
+{
+	for(uint32_t i=0; i<IPC_RPC_MAX_PENDING; i++)
+		m_pending[i] = nullptr;
+}
+
+/**
+	@brief Sends a request without waiting for the response
+
+	@param method	Method ID
+	@param request	Request payload
+	@param len		Request payload size
+	@param call		Completion state, updated when the response arrives
+	@param task		Task to wake when the response arrives (may be null, if the caller polls call.IsPending())
+
+	@return False if the request couldn't be sent right now (too many calls in flight, or the ring is full)
+ */
+bool IPCRPCClient::Call(uint32_t method, const void* request, uint32_t len, IPCRPCCall& call, Task* task)
+{
+	if(!m_tx || (m_pendingCount >= IPC_RPC_MAX_PENDING) )
+		return false;
+
+	auto buf = m_tx->Reserve(sizeof(IPCRPCHeader) + len);
+	if(!buf)
+		return false;
+
+	//Zero is never used as a correlation ID so it can't match a call that was never sent
+	uint32_t seq = m_nextSeq ++;
+	if(m_nextSeq == 0)
+		m_nextSeq = 1;
+
+	//Register the call before the request goes out, since the response might beat us back
+	for(uint32_t i=0; i<IPC_RPC_MAX_PENDING; i++)
+	{
+		if(m_pending[i] == nullptr)
+		{
+			m_pending[i] = &call;
+			break;
+		}
+	}
+	m_pendingCount ++;
+	call.m_task = task;
+	call.m_seq = seq;
+	call.m_status = IPC_RPC_PENDING;
+
+	IPCRPCHeader hdr = { method, seq, IPC_RPC_OK };
+	memcpy(buf, &hdr, sizeof(hdr));
+	memcpy(buf + sizeof(hdr), request, len);
+	m_tx->Commit(sizeof(hdr) + len);
+	return true;
+}
+
+/**
+	@brief Gives up on an outstanding call
+
+	The call object may be reused or destroyed afterwards. If the response arrives later it's discarded.
+ */
+void IPCRPCClient::Cancel(IPCRPCCall& call)
+{
+	for(uint32_t i=0; i<IPC_RPC_MAX_PENDING; i++)
+	{
+		if(m_pending[i] == &call)
+		{
+			m_pending[i] = nullptr;
+			m_pendingCount --;
+			call.m_status = IPC_RPC_CANCELLED;
+			return;
+		}
+	}
+}
+
+/**
+	@brief Processes incoming responses
+ */
+void IPCRPCClient::Iteration()
+{
+	if(!m_rx)
+		return;
+
+	BeginPoll();
+
+	uint32_t len;
+	uint8_t* buf;
+	while( (buf = m_rx->Peek(len)) != nullptr)
+	{
+		if(len >= sizeof(IPCRPCHeader))
+		{
+			IPCRPCHeader hdr;
+			memcpy(&hdr, buf, sizeof(hdr));
+			Complete(hdr, buf + sizeof(hdr), len - sizeof(hdr));
+		}
+		else
+			m_orphans ++;
+
+		m_rx->Release();
+	}
+
+	EndPoll();
+}
+
+/**
+	@brief Matches a response up with its call and completes it
+ */
+void IPCRPCClient::Complete(const IPCRPCHeader& hdr, const uint8_t* payload, uint32_t len)
+{
+	for(uint32_t i=0; i<IPC_RPC_MAX_PENDING; i++)
+	{
+		auto call = m_pending[i];
+		if(!call || (call->m_seq != hdr.seq) )
+			continue;
+
+		m_pending[i] = nullptr;
+		m_pendingCount --;
+
+		//Failed calls have no response payload
+		int32_t status = hdr.status;
+		if(status == IPC_RPC_OK)
+		{
+			if(len == call->m_responseSize)
+				memcpy(call->m_response, payload, len);
+			else
+				status = IPC_RPC_BAD_RESPONSE;
+		}
+		call->m_status = status;
+
+		if(call->m_task)
+			call->m_task->Wake();
+		return;
+	}
+
+	m_orphans ++;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IPCRPCServer
+
+IPCRPCServer::IPCRPCServer()
+	: m_requests(0)
+{
+}
+
+/**
+	@brief Handles incoming requests
+
+	Each request is passed to the handler in place, and the handler writes its response straight into the reply ring.
+	If the reply ring is full the request is left in the ring and retried on the next pass through the main loop.
+ */
+void IPCRPCServer::Iteration()
+{
+	if(!m_rx)
+		return;
+
+	BeginPoll();
+
+	uint32_t len;
+	uint8_t* buf;
+	while( (buf = m_rx->Peek(len)) != nullptr)
+	{
+		//Drop malformed messages
+		if(len < sizeof(IPCRPCHeader))
+		{
+			m_rx->Release();
+			continue;
+		}
+
+		IPCRPCHeader hdr;
+		memcpy(&hdr, buf, sizeof(hdr));
+
+		//Wait for the client to make room for the response
+		uint32_t resplen = GetResponseSize(hdr.method);
+		auto out = m_tx->Reserve(sizeof(hdr) + resplen);
+		if(!out)
+		{
+			Wake();
+			break;
+		}
+
+		hdr.status = Dispatch(hdr.method, buf + sizeof(hdr), len - sizeof(hdr), out + sizeof(hdr));
+		if(hdr.status != IPC_RPC_OK)
+			resplen = 0;
+		memcpy(out, &hdr, sizeof(hdr));
+
+		m_tx->Commit(sizeof(hdr) + resplen);
+		m_rx->Release();
+		m_requests ++;
+	}
+
+	EndPoll();
+}
+
+#endif
+#endif
+#endif
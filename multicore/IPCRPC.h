@@ -0,0 +1,338 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef IPCRPC_h
+#define IPCRPC_h
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+
+#include "IPCDescriptorTable.h"
+#include "IPCInterruptDispatcher.h"
+#include <type_traits>
+
+#if NUM_IPC_RING_CHANNELS > 0
+
+#ifndef IPC_RPC_MAX_PENDING
+#define IPC_RPC_MAX_PENDING 8
+#endif
+
+/**
+	@file
+	@brief Typed request/response RPC between cores, over an IPCRingChannel
+
+	An interface is described by an X-macro listing each method with its request and response types:
+
+	@code
+	#define CRYPTO_RPC_METHODS(X) \
+		X(Encrypt, EncryptRequest, EncryptResponse) \
+		X(Hash, HashRequest, HashResponse)
+
+	IPC_RPC_INTERFACE(Crypto, CRYPTO_RPC_METHODS)
+	@endcode
+
+	which generates:
+	* CryptoClient, with a non-blocking stub per method:
+	  bool Encrypt(const EncryptRequest& req, IPCRPCReply<EncryptResponse>& reply, Task* task = nullptr)
+	* CryptoServer, with a pure virtual handler per method for the implementation to override:
+	  int32_t Encrypt(const EncryptRequest& req, EncryptResponse& resp)
+
+	Request and response types are marshalled by copying them into the ring as-is, so they must be trivially copyable
+	and (like the descriptor table) use stdint types only, to have the same layout on both cores.
+
+	Method IDs are the hash of the method name, so a client and server built from the same interface description
+	always agree, and a hash collision within an interface is a compile error (duplicate case label).
+
+	Each call carries a sequence number as its correlation ID, so up to IPC_RPC_MAX_PENDING calls per client can be in
+	flight at once and responses are matched up regardless of order. When a response arrives the client copies it
+	into the caller's IPCRPCReply, marks it complete, and wakes the task passed to the stub (if any).
+
+	The server handles requests in place in the shared ring and writes its response directly into the reply ring, so
+	neither side copies the request on the way in.
+
+	Client and server are both tasks: add the client to the task list of the core making calls, and the server to the
+	task list of the core doing the work. Each interface needs its own ring channel.
+ */
+
+///@brief Status of an RPC call (positive values are application defined error codes returned by the handler)
+enum IPCRPCStatus : int32_t
+{
+	IPC_RPC_OK				= 0,	//call completed successfully
+	IPC_RPC_PENDING			= -1,	//waiting for the response
+	IPC_RPC_NO_METHOD		= -2,	//server doesn't implement the requested method
+	IPC_RPC_BAD_REQUEST		= -3,	//request was the wrong size for the method
+	IPC_RPC_BAD_RESPONSE	= -4,	//response was the wrong size for the reply
+	IPC_RPC_CANCELLED		= -5	//caller gave up on the call
+};
+
+///@brief Header at the start of every RPC request and response message
+struct IPCRPCHeader
+{
+	///@brief Method ID (hash of the method name)
+	uint32_t method;
+
+	///@brief Correlation ID, copied from the request to the response
+	uint32_t seq;
+
+	///@brief Status of the call (ignored in requests)
+	int32_t status;
+};
+
+//Ring payloads start 4 bytes into an 8-byte aligned record, so this keeps the RPC payload 8-byte aligned
+static_assert(sizeof(IPCRPCHeader) == 12, "IPCRPCHeader must be 12 bytes");
+
+/**
+	@brief Completion state for one outstanding call
+
+	Must stay in place (not go out of scope) until the call completes or is cancelled.
+ */
+class IPCRPCCall
+{
+public:
+	IPCRPCCall(void* response, uint32_t size)
+		: m_task(nullptr)
+		, m_response(response)
+		, m_responseSize(size)
+		, m_seq(0)
+		, m_status(IPC_RPC_OK)
+	{}
+
+	IPCRPCCall(const IPCRPCCall&) = delete;
+	IPCRPCCall& operator=(const IPCRPCCall&) = delete;
+
+	///@brief Returns true if the call hasn't completed yet
+	bool IsPending() const
+	{ return m_status == IPC_RPC_PENDING; }
+
+	///@brief Returns true if the call completed with IPC_RPC_OK
+	bool Succeeded() const
+	{ return m_status == IPC_RPC_OK; }
+
+	int32_t GetStatus() const
+	{ return m_status; }
+
+protected:
+	friend class IPCRPCClient;
+
+	///@brief Task to wake on completion
+	Task* m_task;
+
+	///@brief Buffer for the response payload
+	void* m_response;
+
+	///@brief Expected response size
+	uint32_t m_responseSize;
+
+	///@brief Correlation ID of the request
+	uint32_t m_seq;
+
+	///@brief Current status
+	volatile int32_t m_status;
+};
+
+/**
+	@brief Completion state and response storage for a call returning T
+ */
+template<class T>
+class IPCRPCReply : public IPCRPCCall
+{
+public:
+	IPCRPCReply()
+		: IPCRPCCall(&m_value, sizeof(T))
+	{}
+
+	///@brief The response (only valid once Succeeded() returns true)
+	T m_value;
+};
+
+/**
+	@brief Common base for RPC clients and servers: one ring to send on, one to receive on
+ */
+class IPCRPCEndpoint : public Task
+{
+public:
+	IPCRPCEndpoint();
+
+	void SetChannel(IPCRingChannel* channel);
+	void SetInterruptDispatcher(IPCInterruptDispatcher* dispatcher);
+
+protected:
+	void BeginPoll();
+	void EndPoll();
+
+	///@brief Ring we send on
+	IPCRingBuffer* m_tx;
+
+	///@brief Ring we receive on
+	IPCRingBuffer* m_rx;
+
+	///@brief Interrupt dispatcher to get RX wakeups from (null to poll)
+	IPCInterruptDispatcher* m_dispatcher;
+};
+
+/**
+	@brief Client side of an RPC interface (use the class generated by IPC_RPC_INTERFACE rather than this directly)
+ */
+class IPCRPCClient : public IPCRPCEndpoint
+{
+public:
+	IPCRPCClient();
+
+	bool Call(uint32_t method, const void* request, uint32_t len, IPCRPCCall& call, Task* task);
+	void Cancel(IPCRPCCall& call);
+
+	///@brief Number of calls waiting for a response
+	uint32_t GetPendingCount() const
+	{ return m_pendingCount; }
+
+	///@brief Number of responses discarded because they didn't match an outstanding call
+	uint32_t GetOrphanCount() const
+	{ return m_orphans; }
+
+	virtual void Iteration() override;
+
+protected:
+	void Complete(const IPCRPCHeader& hdr, const uint8_t* payload, uint32_t len);
+
+	///@brief Outstanding calls (null for free slots)
+	IPCRPCCall* m_pending[IPC_RPC_MAX_PENDING];
+
+	///@brief Number of non-null entries in m_pending
+	uint32_t m_pendingCount;
+
+	///@brief Correlation ID for the next call
+	uint32_t m_nextSeq;
+
+	///@brief Responses with no matching call (late responses to cancelled calls, etc)
+	uint32_t m_orphans;
+};
+
+/**
+	@brief Server side of an RPC interface (use the class generated by IPC_RPC_INTERFACE rather than this directly)
+ */
+class IPCRPCServer : public IPCRPCEndpoint
+{
+public:
+	IPCRPCServer();
+
+	virtual void Iteration() override;
+
+	///@brief Number of requests handled
+	uint32_t GetRequestCount() const
+	{ return m_requests; }
+
+protected:
+	/**
+		@brief Gets the size of the response payload for a method
+
+		@return Response size, or zero if the method is unknown
+	 */
+	virtual uint32_t GetResponseSize(uint32_t method) =0;
+
+	/**
+		@brief Runs the handler for a method
+
+		@param req		Request payload
+		@param reqlen	Request payload size
+		@param resp		Buffer for the response payload, GetResponseSize(method) bytes in size
+
+		@return Status to send back to the caller
+	 */
+	virtual int32_t Dispatch(uint32_t method, const uint8_t* req, uint32_t reqlen, uint8_t* resp) =0;
+
+	///@brief Number of requests handled
+	uint32_t m_requests;
+};
+
+///@brief Method ID for an RPC method
+#define IPC_RPC_METHOD_ID(name) IPCChannelID(#name)
+
+//Per-method expansions used by IPC_RPC_INTERFACE
+#define IPC_RPC_CLIENT_STUB(name, req, resp) \
+	bool name(const req& request, IPCRPCReply<resp>& reply, Task* task = nullptr) \
+	{ return Call(IPC_RPC_METHOD_ID(name), &request, sizeof(request), reply, task); }
+
+#define IPC_RPC_SERVER_HANDLER(name, req, resp) \
+	virtual int32_t name(const req& request, resp& response) =0;
+
+#define IPC_RPC_SERVER_SIZE(name, req, resp) \
+	case IPC_RPC_METHOD_ID(name): \
+		return sizeof(resp);
+
+#define IPC_RPC_SERVER_CASE(name, req, resp) \
+	case IPC_RPC_METHOD_ID(name): \
+		static_assert(std::is_trivially_copyable<req>::value, #req " must be trivially copyable"); \
+		static_assert(std::is_trivially_copyable<resp>::value, #resp " must be trivially copyable"); \
+		static_assert(alignof(req) <= 8, #req " must not need more than 8 byte alignment"); \
+		static_assert(alignof(resp) <= 8, #resp " must not need more than 8 byte alignment"); \
+		if(reqlen != sizeof(req)) \
+			return IPC_RPC_BAD_REQUEST; \
+		return name(*reinterpret_cast<const req*>(request), *reinterpret_cast<resp*>(response));
+
+/**
+	@brief Generates iface##Client and iface##Server classes from an X-macro method list
+ */
+#define IPC_RPC_INTERFACE(iface, METHODS) \
+	class iface##Client : public IPCRPCClient \
+	{ \
+	public: \
+		METHODS(IPC_RPC_CLIENT_STUB) \
+	}; \
+	\
+	class iface##Server : public IPCRPCServer \
+	{ \
+	protected: \
+		METHODS(IPC_RPC_SERVER_HANDLER) \
+		\
+		virtual uint32_t GetResponseSize(uint32_t method) override \
+		{ \
+			switch(method) \
+			{ \
+				METHODS(IPC_RPC_SERVER_SIZE) \
+				default: \
+					return 0; \
+			} \
+		} \
+		\
+		virtual int32_t Dispatch(uint32_t method, const uint8_t* request, uint32_t reqlen, uint8_t* response) override \
+		{ \
+			switch(method) \
+			{ \
+				METHODS(IPC_RPC_SERVER_CASE) \
+				default: \
+					return IPC_RPC_NO_METHOD; \
+			} \
+		} \
+	};
+
+#endif
+#endif
+#endif
+
+#endif
@@ -0,0 +1,225 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include "IPCDescriptorTable.h"
+
+/**
+	@file
+	@brief Implementation of IPCRingBuffer
+ */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction / destruction
+
+IPCRingBuffer::IPCRingBuffer()
+{
+	#ifdef PRIMARY_CORE
+		//Clear to empty
+		m_buffer.Set(nullptr);
+		m_size = 0;
+		m_setmask = 0;
+		m_clearmask = 0;
+		m_primaryTx = 0;
+		m_writeIndex = 0;
+		m_reserveIndex = 0;
+		m_readIndex = 0;
+		m_peekIndex = 0;
+	#endif
+}
+
+void IPCRingBuffer::Initialize(
+	volatile uint8_t* buf, uint32_t size, uint32_t channel, volatile IPCC* ipcc, bool primaryTx)
+{
+	m_buffer.Set(buf);
+	m_ipcc.Set(ipcc);
+	m_size = size;
+	m_setmask = 1 << (16 + channel);
+	m_clearmask = 1 << channel;
+	m_primaryTx = primaryTx;
+	m_writeIndex = 0;
+	m_reserveIndex = 0;
+	m_readIndex = 0;
+	m_peekIndex = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Producer side
+
+/**
+	@brief Reserves contiguous space for a message
+
+	Messages (including the 4 byte header and padding) can be at most half the buffer size, otherwise a message that
+	needs to wrap might never fit even with the ring empty.
+
+	@param len	Max payload size, in bytes
+
+	@return Pointer to write the payload to, or null if there's not enough free space right now
+ */
+uint8_t* IPCRingBuffer::Reserve(uint32_t len)
+{
+	uint32_t rec = RecordSize(len);
+	if(rec > (m_size / 2) )
+		return nullptr;
+
+	//Get the consumer's latest read index
+	IPCInvalidateRange(&m_readIndex, sizeof(m_readIndex));
+
+	uint32_t wr = m_writeIndex;
+	uint32_t used = wr - IPCLoadShared(m_readIndex);
+	uint32_t offset = wr & (m_size - 1);
+	uint32_t tail = m_size - offset;
+
+	//Skip the rest of the buffer if the message won't fit before the end
+	uint32_t skip = 0;
+	if(rec > tail)
+		skip = tail;
+
+	if( (used + skip + rec) > m_size)
+		return nullptr;
+
+	m_reserveIndex = wr + skip;
+	return reinterpret_cast<uint8_t*>(GetHeader(m_reserveIndex) + 1);
+}
+
+/**
+	@brief Publishes a message previously set up with Reserve(), and rings the doorbell if the ring was empty
+
+	@param len	Actual payload size, in bytes (no more than what was reserved)
+ */
+void IPCRingBuffer::Commit(uint32_t len)
+{
+	uint32_t wr = m_writeIndex;
+
+	//Mark the end of the buffer as unused if we wrapped
+	if(m_reserveIndex != wr)
+	{
+		auto marker = GetHeader(wr);
+		*marker = WRAP_MARKER;
+		IPCCleanRange(marker, sizeof(uint32_t));
+	}
+
+	auto hdr = GetHeader(m_reserveIndex);
+	*hdr = len;
+	IPCCleanRange(hdr, len + sizeof(uint32_t));
+
+	//Message has to be visible before the index update, and the index update before we look at the read index
+	IPCMemoryBarrier();
+	IPCStoreShared(m_writeIndex, m_reserveIndex + RecordSize(len));
+	IPCCleanRange(&m_writeIndex, sizeof(m_writeIndex));
+	IPCMemoryBarrier();
+	IPCInvalidateRange(&m_readIndex, sizeof(m_readIndex));
+
+	//Only send a doorbell if the consumer had caught up with us (if it hasn't, it's still draining and will see the
+	//new message before it stops)
+	if(IPCLoadShared(m_readIndex) != wr)
+		return;
+
+	if(m_primaryTx)
+		m_ipcc->SetPrimaryToSecondaryChannelBusy(m_setmask);
+	else
+		m_ipcc->SetSecondaryToPrimaryChannelBusy(m_setmask);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Consumer side
+
+/**
+	@brief Checks for, and clears, a pending doorbell
+
+	Call this before draining the ring, not after, so a doorbell for a message committed during the drain isn't lost.
+
+	@return True if the doorbell had been rung
+ */
+bool IPCRingBuffer::AcknowledgeDoorbell()
+{
+	if(m_primaryTx)
+	{
+		if(m_ipcc->IsPrimaryToSecondaryChannelFree(m_clearmask))
+			return false;
+		m_ipcc->SetPrimaryToSecondaryChannelFree(m_clearmask);
+	}
+	else
+	{
+		if(m_ipcc->IsSecondaryToPrimaryChannelFree(m_clearmask))
+			return false;
+		m_ipcc->SetSecondaryToPrimaryChannelFree(m_clearmask);
+	}
+
+	IPCMemoryBarrier();
+	return true;
+}
+
+/**
+	@brief Gets the oldest message in the ring without removing it
+
+	@param len	Payload size, in bytes
+
+	@return Pointer to the payload, or null if the ring is empty
+ */
+uint8_t* IPCRingBuffer::Peek(uint32_t& len)
+{
+	//Get the producer's latest write index
+	IPCInvalidateRange(&m_writeIndex, sizeof(m_writeIndex));
+
+	uint32_t rd = m_readIndex;
+	if(rd == IPCLoadShared(m_writeIndex))
+		return nullptr;
+
+	//Don't read the message until we've seen the index update that published it
+	IPCMemoryBarrier();
+
+	auto hdr = GetHeader(rd);
+	IPCInvalidateRange(hdr, sizeof(uint32_t));
+	if(*hdr == WRAP_MARKER)
+	{
+		rd += m_size - (rd & (m_size - 1));
+		hdr = GetHeader(rd);
+		IPCInvalidateRange(hdr, sizeof(uint32_t));
+	}
+
+	//Now that we know how big the message is, drop any stale copy of the rest of it
+	m_peekIndex = rd;
+	len = *hdr;
+	IPCInvalidateRange(hdr + 1, len);
+	return reinterpret_cast<uint8_t*>(hdr + 1);
+}
+
+/**
+	@brief Frees the message returned by the last Peek()
+ */
+void IPCRingBuffer::Release()
+{
+	uint32_t len = *GetHeader(m_peekIndex);
+
+	//Finish reading the message before handing the space back to the producer
+	IPCMemoryBarrier();
+	IPCStoreShared(m_readIndex, m_peekIndex + RecordSize(len));
+	IPCCleanRange(&m_readIndex, sizeof(m_readIndex));
+}
@@ -0,0 +1,151 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef IPCRingBuffer_h
+#define IPCRingBuffer_h
+
+#ifdef NUM_SECONDARY_CORES
+#ifdef HAVE_IPCC
+
+#include <peripheral/IPCC.h>
+#include "IPCCache.h"
+
+/**
+	@brief Single-producer single-consumer ring buffer of variable length messages, for use between cores
+
+	Unlike UnidirectionalIPCFifo, any number of messages can be in flight at once, and messages are built and consumed
+	in place in the shared buffer with no intermediate copies:
+
+	Producer:
+	* Reserve(len) to get a pointer to len bytes of contiguous space (null if the ring is too full)
+	* Write the message directly into it
+	* Commit(len) to publish it (len may be less than the reserved size)
+
+	Consumer:
+	* AcknowledgeDoorbell() when the IPCC channel interrupt fires (or when polling)
+	* Peek(len) to get a pointer to the oldest message (null if the ring is empty)
+	* Release() once done with it
+	* Repeat until Peek() returns null, since the doorbell only rings on an empty to non-empty transition
+
+	Each message is stored as a 32-bit length header followed by the payload, padded to an 8 byte boundary. If a
+	message doesn't fit between the write pointer and the end of the buffer, a wrap marker is written and the message
+	goes at the start of the buffer instead.
+
+	Read and write indexes are free-running byte counts (masked to get a buffer offset), each in its own cache line so
+	the producer and consumer never write to the same line.
+
+	Must use stdint types only, and be structured to have the same memory layout on armv8-m and aarch64.
+ */
+class IPCRingBuffer
+{
+public:
+	IPCRingBuffer();
+
+	void Initialize(volatile uint8_t* buf, uint32_t size, uint32_t channel, volatile IPCC* ipcc, bool primaryTx);
+
+	///@brief Size of the buffer, in bytes
+	uint32_t size()
+	{ return m_size; }
+
+	volatile uint8_t* GetBuffer()
+	{ return m_buffer.Get(); }
+
+	///@brief Number of bytes currently used by messages (including headers and padding)
+	uint32_t ReadSize()
+	{ return IPCLoadShared(m_writeIndex) - IPCLoadShared(m_readIndex); }
+
+	bool IsEmpty()
+	{ return IPCLoadShared(m_writeIndex) == IPCLoadShared(m_readIndex); }
+
+	///@brief Gets the IPCC channel number used for this ring's doorbell
+	uint32_t GetChannel()
+	{ return __builtin_ctz(m_clearmask); }
+
+	//Producer API
+	uint8_t* Reserve(uint32_t len);
+	void Commit(uint32_t len);
+
+	//Consumer API
+	bool AcknowledgeDoorbell();
+	uint8_t* Peek(uint32_t& len);
+	void Release();
+
+	///@brief Length header value marking the rest of the buffer as unused
+	static const uint32_t WRAP_MARKER = 0xffffffff;
+
+protected:
+	///@brief Size of a message record including header and padding
+	static uint32_t RecordSize(uint32_t len)
+	{ return (len + sizeof(uint32_t) + 7) & ~7; }
+
+	uint32_t* GetHeader(uint32_t index)
+	{ return reinterpret_cast<uint32_t*>(const_cast<uint8_t*>(m_buffer.Get()) + (index & (m_size - 1))); }
+
+	//Configuration (written once by the primary at allocation time)
+
+	///@brief The actual data buffer
+	PaddedPointer<uint8_t> m_buffer;
+
+	///@brief The IPC controller
+	PaddedPointer<IPCC> m_ipcc;
+
+	///@brief Size of the buffer (must be a power of two)
+	volatile uint32_t m_size;
+
+	///@brief Channel ID set mask
+	uint32_t m_setmask;
+
+	///@brief Channel ID clear mask
+	uint32_t m_clearmask;
+
+	///@brief True if primary -> secondary path
+	uint32_t m_primaryTx;
+
+	//Producer cache line
+
+	///@brief Index at which the next message will be written
+	volatile uint32_t m_writeIndex __attribute__((aligned(IPC_CACHE_LINE_SIZE)));
+
+	///@brief Index the pending reservation starts at (after any wrap marker)
+	uint32_t m_reserveIndex;
+
+	//Consumer cache line
+
+	///@brief Index of the oldest unread message
+	volatile uint32_t m_readIndex __attribute__((aligned(IPC_CACHE_LINE_SIZE)));
+
+	///@brief Index of the message returned by the last Peek()
+	uint32_t m_peekIndex;
+
+	//(class alignment pads the consumer line out to a full 64 bytes)
+};
+
+#endif
+#endif
+#endif
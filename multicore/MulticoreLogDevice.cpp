@@ -33,30 +33,140 @@
 
 #ifdef MULTICORE
 
-MulticoreLogDevice::MulticoreLogDevice()
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MulticoreLogRing
+
+/**
+	@brief Appends data to the ring (producer side)
+
+	Never blocks: anything which doesn't fit is dropped.
+
+	@return Number of bytes written
+ */
+uint32_t MulticoreLogRing::Write(const char* buf, uint32_t len)
 {
+	uint32_t head = m_head;
+	uint32_t space = LOG_TXBUF_SIZE - (head - __atomic_load_n(&m_tail, __ATOMIC_ACQUIRE));
+	if(len > space)
+	{
+		m_drops += len - space;
+		len = space;
+	}
+
+	//Copy in up to two pieces, if we wrap
+	uint32_t offset = head & (LOG_TXBUF_SIZE - 1);
+	uint32_t first = LOG_TXBUF_SIZE - offset;
+	if(first > len)
+		first = len;
+	memcpy(m_buffer + offset, buf, first);
+	memcpy(m_buffer, buf + first, len - first);
+
+	__atomic_store_n(&m_head, head + len, __ATOMIC_RELEASE);
+	return len;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MulticoreLogDrainTask
+
+/**
+	@brief Pushes as much pending log data from each core as the IPC FIFOs will take right now
+ */
+void MulticoreLogDrainTask::Iteration()
+{
+	bool stalled = false;
 	for(uint32_t i=0; i<NUM_SECONDARY_CORES; i++)
 	{
+		auto chan = m_device.GetChannel(i);
+		if(!chan)
+			continue;
+
+		auto& ring = m_device.GetRing(i);
+		auto& fifo = chan->GetSecondaryFifo();
+
+		const char* data;
+		uint32_t len;
+		while( (len = ring.Peek(data)) != 0)
+		{
+			if(len > fifo.size())
+				len = fifo.size();
+
+			if(fifo.TryPush(reinterpret_cast<const uint8_t*>(data), len) != IPC_PUSH_OK)
+			{
+				//Come back when the peer has taken the last block
+				if(m_dispatcher)
+					m_dispatcher->ArmTx(fifo.GetChannel(), this);
+				else
+					stalled = true;
+				break;
+			}
+			ring.Consume(len);
+		}
+	}
+
+	if(stalled)
+		Wake();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MulticoreLogDevice
+
+MulticoreLogDevice* MulticoreLogDevice::s_instance = nullptr;
+
+MulticoreLogDevice::MulticoreLogDevice()
+	: m_drainTask(*this)
+{
+	for(uint32_t i=0; i<NUM_SECONDARY_CORES; i++)
 		m_channels[i] = nullptr;
-		m_writePointers[i] = 0;
-		memset(m_txBuffers[i], 0, LOG_TXBUF_SIZE);
+
+	s_instance = this;
+}
+
+/**
+	@brief Adds the drain task to core 0's task list, unless the application already put it on some core's list
+
+	Called by CoreMain() on core 0 before the scheduler is initialized. Overrides the weak no-op in core/main.cpp.
+ */
+void RegisterMulticoreLogDrainTask()
+{
+	auto dev = MulticoreLogDevice::GetInstance();
+	if(!dev)
+		return;
+
+	auto task = &dev->GetDrainTask();
+	for(uint32_t core=0; core<NUM_SECONDARY_CORES; core++)
+	{
+		for(auto t : g_tasks[core])
+		{
+			if(t == task)
+				return;
+		}
 	}
+
+	if(g_tasks[0].full())
+	{
+		g_log(Logger::ERROR, "No task slot for the multicore log drain task, log output from other cores is lost\n");
+		return;
+	}
+	g_tasks[0].push_back(task);
+}
+
+/**
+	@brief Logs a block of data from the current core without blocking
+ */
+void MulticoreLogDevice::Write(const char* buf, uint32_t len)
+{
+	if(m_rings[GetCurrentCore()].Write(buf, len))
+		m_drainTask.Wake();
 }
 
 void MulticoreLogDevice::PrintBinary(char ch)
 {
-	auto nchan = GetCurrentCore();
-	auto& wptr = m_writePointers[nchan];
-	m_txBuffers[nchan][wptr] = ch;
-	wptr ++;
-
-	//Flush log buffer when it fills up out of necessity
-	if(wptr == LOG_TXBUF_SIZE)
-		Flush();
-
-	//Flush log buffer at end of line if we're pretty full
-	if( (ch == '\n') && (wptr > (LOG_TXBUF_SIZE - 128) ) )
-		Flush();
+	Write(&ch, 1);
+}
+
+void MulticoreLogDevice::PrintString(const char* str)
+{
+	Write(str, strlen(str));
 }
 
 char MulticoreLogDevice::BlockingRead()
@@ -64,19 +174,13 @@ char MulticoreLogDevice::BlockingRead()
 	return 0;
 }
 
+/**
+	@brief Makes sure the drain task will run, without sending anything from the caller's context
+ */
 void MulticoreLogDevice::Flush()
 {
-	//only flush the current core's log buffer to avoid potential races
-	auto nchan = GetCurrentCore();
-	auto& wptr = m_writePointers[nchan];
-	auto pchan = m_channels[nchan];
-
-	//Push to the IPC buffer
-	if(pchan && wptr)
-		pchan->GetSecondaryFifo().Push(reinterpret_cast<const uint8_t*>(m_txBuffers[nchan]), wptr);
-
-	//and mark our local fifo as free
-	wptr = 0;
+	if(!m_rings[GetCurrentCore()].IsEmpty())
+		m_drainTask.Wake();
 }
 
 #endif
@@ -33,13 +33,117 @@
 #ifdef MULTICORE
 
 #ifndef LOG_TXBUF_SIZE
-#define LOG_TXBUF_SIZE 256
+#define LOG_TXBUF_SIZE 1024
 #endif
 
+static_assert( (LOG_TXBUF_SIZE & (LOG_TXBUF_SIZE - 1)) == 0, "LOG_TXBUF_SIZE must be a power of two");
+
 #include "IPCDescriptorTable.h"
+#include "IPCInterruptDispatcher.h"
+
+/**
+	@brief Single-producer single-consumer byte ring holding one core's pending log output
+
+	The logging core writes, and the drain task (which may be on another core) reads. Head and tail are free-running
+	byte counts in separate cache lines, so neither side ever waits on or writes to the other's state.
+ */
+class MulticoreLogRing
+{
+public:
+	MulticoreLogRing()
+		: m_head(0)
+		, m_drops(0)
+		, m_tail(0)
+	{}
+
+	uint32_t Write(const char* buf, uint32_t len);
+
+	/**
+		@brief Gets the oldest contiguous run of unread data (consumer side)
+
+		@return Number of bytes available at ptr (zero if the ring is empty)
+	 */
+	uint32_t Peek(const char*& ptr)
+	{
+		uint32_t head = __atomic_load_n(&m_head, __ATOMIC_ACQUIRE);
+		uint32_t offset = m_tail & (LOG_TXBUF_SIZE - 1);
+		uint32_t len = head - m_tail;
+		if(len > (LOG_TXBUF_SIZE - offset))
+			len = LOG_TXBUF_SIZE - offset;
+
+		ptr = m_buffer + offset;
+		return len;
+	}
+
+	///@brief Frees len bytes returned by Peek() (consumer side)
+	void Consume(uint32_t len)
+	{ __atomic_store_n(&m_tail, m_tail + len, __ATOMIC_RELEASE); }
+
+	///@brief Returns true if there's no unread data
+	bool IsEmpty()
+	{ return __atomic_load_n(&m_head, __ATOMIC_ACQUIRE) == __atomic_load_n(&m_tail, __ATOMIC_ACQUIRE); }
+
+	///@brief Number of bytes discarded because the ring was full
+	uint32_t GetDropCount()
+	{ return m_drops; }
+
+protected:
+	///@brief Write index (only written by the producer)
+	uint32_t m_head __attribute__((aligned(IPC_CACHE_LINE_SIZE)));
+
+	///@brief Bytes dropped due to the ring being full (only written by the producer)
+	uint32_t m_drops;
+
+	///@brief Read index (only written by the consumer)
+	uint32_t m_tail __attribute__((aligned(IPC_CACHE_LINE_SIZE)));
+
+	///@brief The log data
+	char m_buffer[LOG_TXBUF_SIZE] __attribute__((aligned(IPC_CACHE_LINE_SIZE)));
+};
+
+class MulticoreLogDevice;
+
+/**
+	@brief Task that moves log data from the per-core rings to the IPC channels
+ */
+class MulticoreLogDrainTask : public Task
+{
+public:
+	MulticoreLogDrainTask(MulticoreLogDevice& device)
+		: Task(false)
+		, m_device(device)
+		, m_dispatcher(nullptr)
+	{}
+
+	///@brief Use TX free interrupts, rather than polling, to find out when a channel drains
+	void SetInterruptDispatcher(IPCInterruptDispatcher* dispatcher)
+	{ m_dispatcher = dispatcher; }
+
+	virtual void Iteration() override;
+
+protected:
+	///@brief The device we're draining
+	MulticoreLogDevice& m_device;
+
+	///@brief Interrupt dispatcher to request TX free wakeups from (null to poll)
+	IPCInterruptDispatcher* m_dispatcher;
+};
 
 /**
 	@brief Log device that logs to one of several IPC descriptor tables depending on the current core ID
+
+	Each core's log output goes into its own lock-free ring (MulticoreLogRing), so logging costs a memcpy, takes
+	bounded time, and never touches the IPCC or waits on the other side. If a ring fills up, the excess is dropped and
+	counted rather than stalling the caller.
+
+	A single drain task (GetDrainTask()) empties all of the rings into their IPC channels as the FIFOs free up. It sleeps
+	while there's nothing to send. CoreMain() adds it to core 0's task list before starting the scheduler; to run it on
+	a different core instead, add it to that core's task list from BSP_Init() or CoreInit() and it will be left alone.
+
+	Only one MulticoreLogDevice per firmware image is supported.
+
+	Each ring has exactly one producer: the core that owns it. Logging from interrupt handlers which can preempt a
+	log call on the same core is not supported.
  */
 class MulticoreLogDevice : public CharacterDevice
 {
@@ -52,7 +156,33 @@ public:
 			m_channels[i] = g_ipcDescriptorTable.FindChannel(name);
 	}
 
+	///@brief Looks up a channel by ID, e.g. LookupChannel(0, IPCChannelID("log0"))
+	void LookupChannel(uint32_t i, uint32_t id)
+	{
+		if(i < NUM_SECONDARY_CORES)
+			m_channels[i] = g_ipcDescriptorTable.FindChannel(id);
+	}
+
+	///@brief Gets the task that moves log data to the other core
+	MulticoreLogDrainTask& GetDrainTask()
+	{ return m_drainTask; }
+
+	///@brief Gets the pending log data for a given core
+	MulticoreLogRing& GetRing(uint32_t i)
+	{ return m_rings[i]; }
+
+	///@brief Gets the IPC channel for a given core
+	IPCDescriptorChannel* GetChannel(uint32_t i)
+	{ return m_channels[i]; }
+
+	void Write(const char* buf, uint32_t len);
+
+	///@brief Gets the most recently constructed log device, or null if there isn't one
+	static MulticoreLogDevice* GetInstance()
+	{ return s_instance; }
+
 	virtual void PrintBinary(char ch) override;
+	virtual void PrintString(const char* str) override;
 	virtual char BlockingRead() override;
 	virtual void Flush() override;
 
@@ -61,11 +191,14 @@ protected:
 	///@brief The IPC channels to the other core
 	IPCDescriptorChannel* m_channels[NUM_SECONDARY_CORES];
 
-	///@brief FIFOs for accumulating log data we haven't yet pushed to the other core
-	char m_txBuffers[NUM_SECONDARY_CORES][LOG_TXBUF_SIZE];
+	///@brief Log data we haven't yet pushed to the other core
+	MulticoreLogRing m_rings[NUM_SECONDARY_CORES];
+
+	///@brief Task emptying m_rings
+	MulticoreLogDrainTask m_drainTask;
 
-	///@brief Write pointers
-	uint32_t m_writePointers[NUM_SECONDARY_CORES];
+	///@brief The log device, for RegisterMulticoreLogDrainTask()
+	static MulticoreLogDevice* s_instance;
 };
 
 #endif
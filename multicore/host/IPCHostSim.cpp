@@ -0,0 +1,358 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include "IPCHostSim.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/**
+	@file
+	@brief Thread harness and benchmarks for the host IPC simulation
+ */
+
+using namespace std::chrono;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Globals normally provided by the BSP
+
+///@brief The simulated IPCC
+volatile ipcc_t IPCC1;
+
+Logger g_log;
+Timer g_logTimer;
+Timebase g_timebase;
+WorkStealingQueue g_workQueues[NUM_SECONDARY_CORES];
+KVS* g_kvs = nullptr;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Simulated timer
+
+///@brief True to run timers off g_fakeTicks instead of the host clock
+static std::atomic<bool> g_fakeTime(false);
+
+///@brief Current simulated time, in 100us ticks
+static std::atomic<uint64_t> g_fakeTicks(0);
+
+static uint64_t GetRealHostTicks()
+{
+	return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count() / 100;
+}
+
+static uint64_t GetHostTicks()
+{
+	if(g_fakeTime)
+		return g_fakeTicks;
+	return GetRealHostTicks();
+}
+
+/**
+	@brief Switches every Timer (and so g_timebase) between the host clock and simulated time
+
+	Simulated time starts from the current host time, so existing timers don't jump, and then only moves when
+	IPCHostAdvanceTime() is called.
+ */
+void IPCHostSetFakeTime(bool fake)
+{
+	if(fake && !g_fakeTime)
+		g_fakeTicks = GetRealHostTicks();
+	g_fakeTime = fake;
+}
+
+/**
+	@brief Moves simulated time forward
+ */
+void IPCHostAdvanceTime(uint32_t ticks)
+{
+	g_fakeTicks += ticks;
+}
+
+Timer::Timer()
+	: m_start(GetHostTicks())
+{
+}
+
+uint32_t Timer::GetCount()
+{
+	return GetHostTicks() - m_start;
+}
+
+void Timer::Sleep(uint32_t ticks)
+{
+	if(g_fakeTime)
+		IPCHostAdvanceTime(ticks);
+	else
+		std::this_thread::sleep_for(microseconds(ticks * 100));
+}
+
+void Timer::Restart()
+{
+	m_start = GetHostTicks();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Core simulation
+
+/**
+	@brief Runs the primary and secondary "cores" as threads, and waits for both to return
+ */
+void IPCHostRunCores(std::function<void()> primary, std::function<void()> secondary)
+{
+	std::thread secondaryThread(secondary);
+	primary();
+	secondaryThread.join();
+}
+
+/**
+	@brief Spin-wait helper: lets the other thread run, since the host may have fewer CPUs than we have spinning cores
+ */
+static void Spin()
+{
+	std::this_thread::yield();
+}
+
+static double GetSeconds(steady_clock::time_point start)
+{
+	return duration<double>(steady_clock::now() - start).count();
+}
+
+/**
+	@brief Fills out latency statistics from a list of round trip times
+ */
+static void ComputeLatency(IPCHostBenchmarkResult& result, std::vector<double>& rtts)
+{
+	if(rtts.empty())
+		return;
+
+	std::sort(rtts.begin(), rtts.end());
+	double sum = 0;
+	for(auto t : rtts)
+		sum += t;
+
+	result.m_minLatency = rtts.front() / 2;
+	result.m_meanLatency = sum / rtts.size() / 2;
+	result.m_p99Latency = rtts[rtts.size() * 99 / 100] / 2;
+	result.m_maxLatency = rtts.back() / 2;
+}
+
+static IPCHostBenchmarkResult MakeResult(uint32_t msgsize, uint32_t count)
+{
+	IPCHostBenchmarkResult result = {};
+	result.m_messages = count;
+	result.m_bytes = static_cast<uint64_t>(msgsize) * count;
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FIFO benchmarks
+
+/**
+	@brief Streams count messages of msgsize bytes from the primary to the secondary
+ */
+IPCHostBenchmarkResult IPCHostFifoThroughput(IPCDescriptorChannel* chan, uint32_t msgsize, uint32_t count)
+{
+	auto& fifo = chan->GetPrimaryFifo();
+	auto result = MakeResult(msgsize, count);
+	std::vector<uint8_t> txbuf(msgsize, 0x55);
+	std::vector<uint8_t> rxbuf(fifo.size());
+
+	auto start = steady_clock::now();
+	IPCHostRunCores(
+		[&]
+		{
+			for(uint32_t i=0; i<count; i++)
+			{
+				while(fifo.TryPush(txbuf.data(), msgsize) == IPC_PUSH_WOULD_BLOCK)
+					Spin();
+			}
+		},
+		[&]
+		{
+			for(uint32_t i=0; i<count; )
+			{
+				if(fifo.Pop(rxbuf.data()))
+					i++;
+				else
+					Spin();
+			}
+		});
+	result.m_seconds = GetSeconds(start);
+
+	return result;
+}
+
+/**
+	@brief Bounces count messages of msgsize bytes from the primary to the secondary and back, one at a time
+ */
+IPCHostBenchmarkResult IPCHostFifoLatency(IPCDescriptorChannel* chan, uint32_t msgsize, uint32_t count)
+{
+	auto& ping = chan->GetPrimaryFifo();
+	auto& pong = chan->GetSecondaryFifo();
+	auto result = MakeResult(msgsize, count);
+	std::vector<double> rtts;
+	rtts.reserve(count);
+
+	auto start = steady_clock::now();
+	IPCHostRunCores(
+		[&]
+		{
+			std::vector<uint8_t> buf(std::max(msgsize, pong.size()), 0x55);
+			for(uint32_t i=0; i<count; i++)
+			{
+				auto tstart = steady_clock::now();
+				ping.Push(buf.data(), msgsize);
+				while(!pong.Pop(buf.data()))
+					Spin();
+				rtts.push_back(duration<double, std::nano>(steady_clock::now() - tstart).count());
+			}
+		},
+		[&]
+		{
+			std::vector<uint8_t> buf(ping.size());
+			for(uint32_t i=0; i<count; i++)
+			{
+				uint32_t len;
+				while( (len = ping.Pop(buf.data())) == 0)
+					Spin();
+				pong.Push(buf.data(), len);
+			}
+		});
+	result.m_seconds = GetSeconds(start);
+
+	ComputeLatency(result, rtts);
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Ring buffer benchmarks
+
+#if NUM_IPC_RING_CHANNELS > 0
+
+/**
+	@brief Streams count messages of msgsize bytes from the primary to the secondary
+ */
+IPCHostBenchmarkResult IPCHostRingThroughput(IPCRingChannel* chan, uint32_t msgsize, uint32_t count)
+{
+	auto& ring = chan->GetPrimaryRing();
+	auto result = MakeResult(msgsize, count);
+
+	auto start = steady_clock::now();
+	IPCHostRunCores(
+		[&]
+		{
+			for(uint32_t i=0; i<count; i++)
+			{
+				uint8_t* buf;
+				while( (buf = ring.Reserve(msgsize)) == nullptr)
+					Spin();
+				memset(buf, 0x55, msgsize);
+				ring.Commit(msgsize);
+			}
+		},
+		[&]
+		{
+			for(uint32_t i=0; i<count; )
+			{
+				ring.AcknowledgeDoorbell();
+
+				uint32_t len;
+				if(ring.Peek(len))
+				{
+					ring.Release();
+					i++;
+				}
+				else
+					Spin();
+			}
+		});
+	result.m_seconds = GetSeconds(start);
+
+	return result;
+}
+
+/**
+	@brief Bounces count messages of msgsize bytes from the primary to the secondary and back, one at a time
+ */
+IPCHostBenchmarkResult IPCHostRingLatency(IPCRingChannel* chan, uint32_t msgsize, uint32_t count)
+{
+	auto& ping = chan->GetPrimaryRing();
+	auto& pong = chan->GetSecondaryRing();
+	auto result = MakeResult(msgsize, count);
+	std::vector<double> rtts;
+	rtts.reserve(count);
+
+	auto start = steady_clock::now();
+	IPCHostRunCores(
+		[&]
+		{
+			for(uint32_t i=0; i<count; i++)
+			{
+				auto tstart = steady_clock::now();
+
+				uint8_t* buf;
+				while( (buf = ping.Reserve(msgsize)) == nullptr)
+					Spin();
+				memset(buf, 0x55, msgsize);
+				ping.Commit(msgsize);
+
+				uint32_t len;
+				while(pong.Peek(len) == nullptr)
+					Spin();
+				pong.Release();
+
+				rtts.push_back(duration<double, std::nano>(steady_clock::now() - tstart).count());
+			}
+		},
+		[&]
+		{
+			for(uint32_t i=0; i<count; i++)
+			{
+				uint32_t len;
+				uint8_t* rxbuf;
+				while( (rxbuf = ping.Peek(len)) == nullptr)
+					Spin();
+
+				//Echo it straight back out of the ring, without an intermediate copy
+				uint8_t* txbuf;
+				while( (txbuf = pong.Reserve(len)) == nullptr)
+					Spin();
+				memcpy(txbuf, rxbuf, len);
+				pong.Commit(len);
+				ping.Release();
+			}
+		});
+	result.m_seconds = GetSeconds(start);
+
+	ComputeLatency(result, rtts);
+	return result;
+}
+
+#endif
@@ -0,0 +1,100 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef IPCHostSim_h
+#define IPCHostSim_h
+
+#include <core/platform.h>
+#include "../IPCDescriptorTable.h"
+#include <functional>
+
+/**
+	@file
+	@brief Host simulation of the multicore IPC primitives
+
+	Builds g_ipcDescriptorTable, UnidirectionalIPCFifo, IPCRingBuffer and g_ipcBufferPool for a PC, with each "core"
+	being a std::thread and a simulated IPCC (see peripheral/IPCC.h in this directory) in place of the hardware. Cache
+	maintenance is a no-op and barriers become C++ fences and atomics (see IPCCache.h), so building with
+	ThreadSanitizer (set CEP_HOST_TSAN in cmake) catches missing or misplaced synchronization in the IPC code.
+
+	Everything is built as the primary core, since both simulated cores share one copy of the descriptor table. The
+	primary thread allocates channels as usual; the secondary thread uses the same channel objects. This means the
+	secondary-only lookups (FindChannel() and FindRingChannel()) are not built or tested here; only the
+	IPCChannelIndex they sit on is.
+
+	The simulated IPCC raises no interrupts. HAVE_IPCC_IRQ is defined so g_ipcInterruptDispatcher exists, and tests
+	call its OnRxInterrupt() and OnTxInterrupt() directly in place of the ISRs.
+
+	Enable with CEP_BUILD_MULTICORE_HOST in a native (not cross compiled) CMake build and link to
+	common-embedded-platform-multicore-host. The parent project provides the etl, embedded-utils and microkvs include
+	paths and the Logger implementation, as it does for firmware builds. The tests in tests/ are registered with
+	ctest.
+ */
+
+///@brief Results of a host IPC benchmark
+struct IPCHostBenchmarkResult
+{
+	///@brief Messages transferred
+	uint32_t m_messages;
+
+	///@brief Payload bytes transferred
+	uint64_t m_bytes;
+
+	///@brief Total run time
+	double m_seconds;
+
+	//One way latency (half the round trip time) in nanoseconds, only filled out by the latency benchmarks
+	double m_minLatency;
+	double m_meanLatency;
+	double m_p99Latency;
+	double m_maxLatency;
+
+	///@brief Messages per second
+	double GetMessageRate() const
+	{ return m_messages / m_seconds; }
+
+	///@brief Payload throughput in MB/s
+	double GetThroughput() const
+	{ return m_bytes / (m_seconds * 1e6); }
+};
+
+void IPCHostRunCores(std::function<void()> primary, std::function<void()> secondary);
+
+void IPCHostSetFakeTime(bool fake);
+void IPCHostAdvanceTime(uint32_t ticks);
+
+IPCHostBenchmarkResult IPCHostFifoThroughput(IPCDescriptorChannel* chan, uint32_t msgsize, uint32_t count);
+IPCHostBenchmarkResult IPCHostFifoLatency(IPCDescriptorChannel* chan, uint32_t msgsize, uint32_t count);
+
+#if NUM_IPC_RING_CHANNELS > 0
+IPCHostBenchmarkResult IPCHostRingThroughput(IPCRingChannel* chan, uint32_t msgsize, uint32_t count);
+IPCHostBenchmarkResult IPCHostRingLatency(IPCRingChannel* chan, uint32_t msgsize, uint32_t count);
+#endif
+
+#endif
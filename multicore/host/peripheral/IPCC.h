@@ -0,0 +1,122 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef IPCC_h
+#define IPCC_h
+
+/**
+	@file
+	@brief Host simulation stand-in for the stm32-cpp IPCC driver
+
+	Same interface as the real driver, but the channel status registers are plain words updated with C++ atomics
+	(release on set/clear, acquire on test), so a doorbell orders the message data the same way the hardware does and
+	ThreadSanitizer can follow it from one simulated core to the other.
+ */
+
+#include <stdint.h>
+
+///@brief Register layout of the IPCC (only the status registers do anything in the simulation)
+struct ipcc_t
+{
+	uint32_t C1CR;
+	uint32_t C1MR;
+	uint32_t C1SCR;
+	uint32_t C1TOC2SR;
+	uint32_t C2CR;
+	uint32_t C2MR;
+	uint32_t C2SCR;
+	uint32_t C2TOC1SR;
+};
+
+extern volatile ipcc_t IPCC1;
+
+/**
+	@brief Pointer padded to 64 bits, so structures containing it have the same layout for 32 and 64 bit cores
+
+	Host pointers are already 64 bits, so there's no padding to add.
+ */
+template<class T>
+class PaddedPointer
+{
+public:
+	void Set(volatile T* ptr)
+	{ m_ptr = ptr; }
+
+	volatile T* Get()
+	{ return m_ptr; }
+
+	volatile T* operator->()
+	{ return m_ptr; }
+
+protected:
+	volatile T* m_ptr;
+};
+
+/**
+	@brief Simulated inter-processor communication controller
+
+	Channel masks are the same as for the real driver: "set" masks have the channel bit in the upper half, "clear" and
+	status masks in the lower half.
+ */
+class IPCC
+{
+public:
+	IPCC(volatile ipcc_t* lane)
+		: m_lane(lane)
+	{}
+
+	void Initialize()
+	{
+		__atomic_store_n(&m_lane->C1TOC2SR, 0, __ATOMIC_RELEASE);
+		__atomic_store_n(&m_lane->C2TOC1SR, 0, __ATOMIC_RELEASE);
+	}
+
+	bool IsPrimaryToSecondaryChannelFree(uint32_t mask) volatile
+	{ return (__atomic_load_n(&m_lane->C1TOC2SR, __ATOMIC_ACQUIRE) & mask) == 0; }
+
+	bool IsSecondaryToPrimaryChannelFree(uint32_t mask) volatile
+	{ return (__atomic_load_n(&m_lane->C2TOC1SR, __ATOMIC_ACQUIRE) & mask) == 0; }
+
+	void SetPrimaryToSecondaryChannelBusy(uint32_t setmask) volatile
+	{ __atomic_fetch_or(&m_lane->C1TOC2SR, setmask >> 16, __ATOMIC_RELEASE); }
+
+	void SetSecondaryToPrimaryChannelBusy(uint32_t setmask) volatile
+	{ __atomic_fetch_or(&m_lane->C2TOC1SR, setmask >> 16, __ATOMIC_RELEASE); }
+
+	void SetPrimaryToSecondaryChannelFree(uint32_t clearmask) volatile
+	{ __atomic_fetch_and(&m_lane->C1TOC2SR, ~clearmask, __ATOMIC_RELEASE); }
+
+	void SetSecondaryToPrimaryChannelFree(uint32_t clearmask) volatile
+	{ __atomic_fetch_and(&m_lane->C2TOC1SR, ~clearmask, __ATOMIC_RELEASE); }
+
+protected:
+	volatile ipcc_t* m_lane;
+};
+
+#endif
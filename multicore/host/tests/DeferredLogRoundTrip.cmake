@@ -0,0 +1,23 @@
+#Runs DeferredLogTest, decodes the stream it writes with tools/deferred-log-decode.py, and checks the result against
+#the text the test expects. Invoked by ctest with TEST_EXE, PYTHON, DECODER and WORK_DIR set.
+
+set(STREAM ${WORK_DIR}/DeferredLogTest.bin)
+set(EXPECTED ${WORK_DIR}/DeferredLogTest.expected.txt)
+set(DECODED ${WORK_DIR}/DeferredLogTest.decoded.txt)
+
+execute_process(COMMAND ${TEST_EXE} ${STREAM} ${EXPECTED} RESULT_VARIABLE rc)
+if(NOT rc EQUAL 0)
+	message(FATAL_ERROR "DeferredLogTest failed (${rc})")
+endif()
+
+execute_process(COMMAND ${PYTHON} ${DECODER} ${TEST_EXE} ${STREAM} OUTPUT_FILE ${DECODED} RESULT_VARIABLE rc)
+if(NOT rc EQUAL 0)
+	message(FATAL_ERROR "deferred-log-decode.py failed (${rc})")
+endif()
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${EXPECTED} ${DECODED} RESULT_VARIABLE rc)
+if(NOT rc EQUAL 0)
+	file(READ ${EXPECTED} expected)
+	file(READ ${DECODED} decoded)
+	message(FATAL_ERROR "Decoded log doesn't match\nExpected:\n${expected}\nDecoded:\n${decoded}")
+endif()
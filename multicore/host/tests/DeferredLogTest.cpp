@@ -0,0 +1,163 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+/**
+	@file
+	@brief Round trip test for DeferredLog: encodes records, streams them with DeferredLogTask, and writes both the
+	binary stream and the text tools/deferred-log-decode.py should turn it back into
+
+	Usage: DeferredLogTest stream.bin expected.txt
+
+	DeferredLogRoundTrip.cmake runs this, then the decoder, and compares the output. Must be linked without PIE, so the
+	format string addresses in the stream match the ones in the ELF.
+ */
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <string>
+#include "../IPCHostSim.h"
+#include "HostTest.h"
+
+/**
+	@brief Character device that collects everything sent to it
+ */
+class CaptureDevice : public CharacterDevice
+{
+public:
+	virtual void PrintBinary(char ch) override
+	{ m_data += ch; }
+
+	virtual char BlockingRead() override
+	{ return 0; }
+
+	std::string m_data;
+};
+
+///@brief Text we expect the decoder to produce
+static std::string g_expected;
+
+/**
+	@brief Adds a line to the expected output, timestamped the way the decoder does it
+ */
+static void __attribute__((format(printf, 1, 2))) Expect(const char* fmt, ...)
+{
+	char text[256];
+	va_list list;
+	va_start(list, fmt);
+	vsnprintf(text, sizeof(text), fmt, list);
+	va_end(list);
+
+	char line[300];
+	snprintf(line, sizeof(line), "[%12.4f] %s",
+		static_cast<uint32_t>(g_timebase.GetTicks()) / 10000.0, text);
+	g_expected += line;
+}
+
+int main(int argc, char* argv[])
+{
+	if(argc != 3)
+	{
+		printf("Usage: DeferredLogTest stream.bin expected.txt\n");
+		return 1;
+	}
+
+	IPCHostSetFakeTime(true);
+
+	CaptureDevice capture;
+	DeferredLogTask task(g_deferredLog, capture);
+
+	//Nothing to do until something is logged
+	HOST_CHECK(!task.IsReady());
+
+	//One record of each argument type
+	int i = -42;
+	uint32_t u = 0xdeadbeef;
+	uint64_t big = 0x123456789abcdef0ULL;
+	size_t sz = 1234567;
+	double d = 3.25;
+	const char* str = "hello";
+	const void* ptr = &capture;
+
+	Expect("Signed %d, unsigned %u\n", i, u);
+	DLOG("Signed %d, unsigned %u\n", i, u);
+	IPCHostAdvanceTime(17);
+
+	Expect("Hex %08x, 64-bit %" PRIx64 ", size %zu\n", u, big, sz);
+	DLOG("Hex %08x, 64-bit %" PRIx64 ", size %zu\n", u, big, sz);
+	IPCHostAdvanceTime(1000);
+
+	Expect("Float %.3f, char %c, string %s\n", d, 'x', str);
+	DLOG("Float %.3f, char %c, string %s\n", d, 'x', str);
+	IPCHostAdvanceTime(5);
+
+	Expect("Pointer 0x%" PRIxPTR ", percent 100%%\n", reinterpret_cast<uintptr_t>(ptr));
+	DLOG("Pointer %p, percent 100%%\n", ptr);
+
+	//Enough records that draining takes several passes
+	for(int n=0; n<20; n++)
+	{
+		IPCHostAdvanceTime(3);
+		Expect("Record %d of %d\n", n, 20);
+		DLOG("Record %d of %d\n", n, 20);
+	}
+
+	HOST_CHECK(task.IsReady());
+	HOST_CHECK_EQUAL(g_deferredLog.GetDropCount(), 0u);
+	HOST_CHECK_EQUAL(g_deferredLog.GetOverflowCount(), 0u);
+
+	//The task keeps itself awake until the ring is empty, then goes idle
+	uint32_t passes = 0;
+	while(task.ConsumeWakeup())
+	{
+		task.Run();
+		passes ++;
+	}
+	HOST_CHECK(passes > 1);
+	HOST_CHECK(g_deferredLog.IsEmpty());
+	HOST_CHECK(!task.IsReady());
+
+	//Write out the stream and what it should decode to
+	FILE* fp = fopen(argv[1], "wb");
+	if(!fp || (fwrite(capture.m_data.data(), 1, capture.m_data.size(), fp) != capture.m_data.size()) )
+	{
+		printf("Couldn't write %s\n", argv[1]);
+		return 1;
+	}
+	fclose(fp);
+
+	fp = fopen(argv[2], "w");
+	if(!fp || (fputs(g_expected.c_str(), fp) < 0) )
+	{
+		printf("Couldn't write %s\n", argv[2]);
+		return 1;
+	}
+	fclose(fp);
+
+	return HOST_TEST_RESULT();
+}
@@ -0,0 +1,74 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#ifndef HostTest_h
+#define HostTest_h
+
+#include <stdio.h>
+
+/**
+	@file
+	@brief Minimal check helpers for the host simulation tests
+
+	Each test is a standalone executable registered with ctest. Failed checks are printed and counted, and the test
+	fails if main() returns nonzero, i.e. HOST_TEST_RESULT().
+ */
+
+///@brief Number of failed checks in this test executable
+static unsigned int g_hostTestFailures = 0;
+
+///@brief Checks a condition, logging (but not aborting on) a failure
+#define HOST_CHECK(cond) \
+	do \
+	{ \
+		if(!(cond)) \
+		{ \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			g_hostTestFailures ++; \
+		} \
+	} while(0)
+
+///@brief Checks that two integer expressions are equal (as unsigned long long), logging both values on a failure
+#define HOST_CHECK_EQUAL(a, b) \
+	do \
+	{ \
+		auto _a = (unsigned long long)(a); \
+		auto _b = (unsigned long long)(b); \
+		if(_a != _b) \
+		{ \
+			printf("%s:%d: check failed: %s == %s (%llu != %llu)\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+			g_hostTestFailures ++; \
+		} \
+	} while(0)
+
+///@brief Exit code for main()
+#define HOST_TEST_RESULT() \
+	(g_hostTestFailures ? (printf("%u check(s) failed\n", g_hostTestFailures), 1) : 0)
+
+#endif
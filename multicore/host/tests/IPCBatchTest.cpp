@@ -0,0 +1,262 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+/**
+	@file
+	@brief Tests for IPCBatchSender and IPCBatchReader, between two simulated cores
+ */
+
+#include "../IPCHostSim.h"
+#include "../IPCBatch.h"
+#include "HostTest.h"
+#include <atomic>
+#include <stdlib.h>
+#include <thread>
+
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_txBuf[256];
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_rxBuf[256];
+
+///@brief Length of test message seq (at least 4 bytes, for the sequence number)
+static uint16_t GetTestLength(uint32_t seq)
+{ return 4 + (seq * 7) % 61; }
+
+static uint8_t GetTestByte(uint32_t seq, uint32_t i)
+{ return seq * 13 + i; }
+
+static void FillTestMessage(uint8_t* buf, uint32_t seq)
+{
+	memcpy(buf, &seq, sizeof(seq));
+	for(uint32_t i=4; i<GetTestLength(seq); i++)
+		buf[i] = GetTestByte(seq, i);
+}
+
+/**
+	@brief Checks one unpacked message
+
+	@return True if it's message seq, intact
+ */
+static bool CheckTestMessage(const uint8_t* msg, uint16_t len, uint32_t seq)
+{
+	uint32_t actual;
+	if(len < sizeof(actual))
+		return false;
+	memcpy(&actual, msg, sizeof(actual));
+	if( (actual != seq) || (len != GetTestLength(seq)) )
+		return false;
+
+	for(uint32_t i=4; i<len; i++)
+	{
+		if(msg[i] != GetTestByte(seq, i))
+			return false;
+	}
+	return true;
+}
+
+/**
+	@brief Framing round trip through IPCBatchReader, including truncated buffers
+ */
+static void TestReader()
+{
+	uint8_t buf[16] = { 3, 0, 'a', 'b', 'c', 0, 0, 2, 0, 'x' };
+	const uint8_t* msg;
+	uint16_t len;
+
+	//Complete: a 3 byte message, then an empty one
+	IPCBatchReader reader(buf, 7);
+	HOST_CHECK(reader.Next(msg, len));
+	HOST_CHECK_EQUAL(len, 3u);
+	HOST_CHECK(!memcmp(msg, "abc", 3));
+	HOST_CHECK(reader.Next(msg, len));
+	HOST_CHECK_EQUAL(len, 0u);
+	HOST_CHECK(!reader.Next(msg, len));
+
+	//Last message claims more bytes than there are
+	IPCBatchReader truncated(buf, 10);
+	HOST_CHECK(truncated.Next(msg, len));
+	HOST_CHECK(truncated.Next(msg, len));
+	HOST_CHECK(!truncated.Next(msg, len));
+}
+
+/**
+	@brief With the peer idle, a message goes out in its own push immediately; further ones wait and go out together
+ */
+static void TestBatching(IPCDescriptorChannel* chan)
+{
+	auto& fifo = chan->GetPrimaryFifo();
+	IPCBatchSender sender(&fifo);
+	uint8_t msg[64];
+	uint8_t rxbuf[256];
+
+	FillTestMessage(msg, 0);
+	HOST_CHECK(sender.Send(msg, GetTestLength(0)));
+	HOST_CHECK_EQUAL(sender.GetBatchCount(), 1u);
+	HOST_CHECK(!sender.IsWakePending());
+
+	//FIFO is now busy until the peer pops it, so these accumulate
+	for(uint32_t seq=1; seq<4; seq++)
+	{
+		FillTestMessage(msg, seq);
+		HOST_CHECK(sender.Send(msg, GetTestLength(seq)));
+	}
+	HOST_CHECK_EQUAL(sender.GetBatchCount(), 1u);
+	HOST_CHECK(sender.IsWakePending());
+
+	//Peer pops the first batch, then our task runs and sends the rest as a single batch
+	uint32_t len = fifo.Pop(rxbuf);
+	IPCBatchReader first(rxbuf, len);
+	const uint8_t* rxmsg;
+	uint16_t rxlen;
+	HOST_CHECK(first.Next(rxmsg, rxlen) && CheckTestMessage(rxmsg, rxlen, 0));
+	HOST_CHECK(!first.Next(rxmsg, rxlen));
+
+	HOST_CHECK(sender.ConsumeWakeup());
+	sender.Run();
+	HOST_CHECK_EQUAL(sender.GetBatchCount(), 2u);
+	HOST_CHECK_EQUAL(sender.GetMessageCount(), 4u);
+
+	len = fifo.Pop(rxbuf);
+	IPCBatchReader second(rxbuf, len);
+	for(uint32_t seq=1; seq<4; seq++)
+		HOST_CHECK(second.Next(rxmsg, rxlen) && CheckTestMessage(rxmsg, rxlen, seq));
+	HOST_CHECK(!second.Next(rxmsg, rxlen));
+
+	//Too big to ever fit in a batch
+	HOST_CHECK(!sender.Send(msg, sizeof(g_txBuf)));
+	HOST_CHECK_EQUAL(sender.GetDropCount(), 1u);
+}
+
+/**
+	@brief Streams messages to the other core, with the sender run the way the main loop would run it
+
+	Every message has to arrive exactly once and in order, and under load there should be fewer pushes than messages.
+ */
+static void TestStream(IPCDescriptorChannel* chan, uint32_t count)
+{
+	auto& fifo = chan->GetPrimaryFifo();
+	IPCBatchSender sender(&fifo);
+	uint32_t errors = 0;
+
+	IPCHostRunCores(
+		[&]
+		{
+			uint8_t msg[64];
+			for(uint32_t seq=0; seq<count; )
+			{
+				//Staging buffer full, give the peer a chance to drain
+				FillTestMessage(msg, seq);
+				if(sender.Send(msg, GetTestLength(seq)))
+					seq ++;
+				else
+					std::this_thread::yield();
+
+				if(sender.ConsumeWakeup())
+					sender.Run();
+			}
+
+			while(sender.ConsumeWakeup())
+				sender.Run();
+		},
+		[&]
+		{
+			uint8_t rxbuf[256];
+			for(uint32_t seq=0; seq<count; )
+			{
+				uint32_t len = fifo.Pop(rxbuf);
+				if(len == 0)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				IPCBatchReader reader(rxbuf, len);
+				const uint8_t* msg;
+				uint16_t msglen;
+				while(reader.Next(msg, msglen))
+				{
+					if(!CheckTestMessage(msg, msglen, seq))
+						errors ++;
+					seq ++;
+				}
+			}
+		});
+
+	HOST_CHECK_EQUAL(errors, 0u);
+	HOST_CHECK_EQUAL(sender.GetMessageCount(), count);
+	HOST_CHECK(sender.GetBatchCount() <= count);
+	printf("%u messages in %u pushes, %u retried sends\n",
+		sender.GetMessageCount(), sender.GetBatchCount(), sender.GetDropCount());
+}
+
+/**
+	@brief Runs the benchmark briefly against a draining peer, to make sure it terminates
+ */
+static void TestBenchmark(IPCDescriptorChannel* chan)
+{
+	auto& fifo = chan->GetPrimaryFifo();
+	std::atomic<bool> done(false);
+
+	IPCHostRunCores(
+		[&]
+		{
+			IPCBatchBenchmark(&fifo, 10);
+			done = true;
+		},
+		[&]
+		{
+			uint8_t rxbuf[256];
+			while(!done)
+			{
+				if(!fifo.Pop(rxbuf))
+					std::this_thread::yield();
+			}
+			while(fifo.Pop(rxbuf))
+			{}
+		});
+
+	HOST_CHECK(!fifo.Peek());
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t count = 20000;
+	if(argc > 1)
+		count = strtoul(argv[1], nullptr, 10);
+
+	auto chan = g_ipcDescriptorTable.AllocateChannel("batch", g_txBuf, sizeof(g_txBuf), g_rxBuf, sizeof(g_rxBuf));
+	HOST_CHECK(chan != nullptr);
+	if(!chan)
+		return HOST_TEST_RESULT();
+
+	TestReader();
+	TestBatching(chan);
+	TestStream(chan, count);
+	TestBenchmark(chan);
+
+	return HOST_TEST_RESULT();
+}
@@ -0,0 +1,90 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+/**
+	@file
+	@brief Runs the IPC coherency test (see IPCCoherencyTest.h) between two simulated cores, in both directions
+
+	The host has no caches to get wrong, so this mostly checks the test itself and the ordering of the index, data
+	and doorbell accesses, which ThreadSanitizer (CEP_HOST_TSAN) can see.
+ */
+
+#include "../IPCHostSim.h"
+#include "../IPCCoherencyTest.h"
+#include "HostTest.h"
+#include <stdlib.h>
+#include <vector>
+
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_fifoTxBuf[512];
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_fifoRxBuf[512];
+
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_ringTxBuf[2048];
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_ringRxBuf[2048];
+
+static void TestFifo(UnidirectionalIPCFifo& tx, UnidirectionalIPCFifo& rx, uint32_t count)
+{
+	std::vector<uint8_t> scratch(rx.size());
+	uint32_t errors = 0;
+	IPCHostRunCores(
+		[&] { IPCCoherencyTestSend(&tx, count); },
+		[&] { errors = IPCCoherencyTestReceive(&rx, scratch.data(), count); });
+	HOST_CHECK_EQUAL(errors, 0u);
+}
+
+static void TestRing(IPCRingBuffer& tx, IPCRingBuffer& rx, uint32_t count)
+{
+	uint32_t errors = 0;
+	IPCHostRunCores(
+		[&] { IPCCoherencyTestSend(&tx, count); },
+		[&] { errors = IPCCoherencyTestReceive(&rx, count); });
+	HOST_CHECK_EQUAL(errors, 0u);
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t count = 2000;
+	if(argc > 1)
+		count = strtoul(argv[1], nullptr, 10);
+
+	auto chan = g_ipcDescriptorTable.AllocateChannel(
+		"coherency", g_fifoTxBuf, sizeof(g_fifoTxBuf), g_fifoRxBuf, sizeof(g_fifoRxBuf));
+	auto ring = g_ipcDescriptorTable.AllocateRingChannel(
+		"coherencyring", g_ringTxBuf, sizeof(g_ringTxBuf), g_ringRxBuf, sizeof(g_ringRxBuf));
+	HOST_CHECK(chan && ring);
+	if(!chan || !ring)
+		return HOST_TEST_RESULT();
+
+	//Sender and receiver sides are the same objects in the simulation, so each direction is just a different FIFO
+	TestFifo(chan->GetPrimaryFifo(), chan->GetPrimaryFifo(), count);
+	TestFifo(chan->GetSecondaryFifo(), chan->GetSecondaryFifo(), count);
+	TestRing(ring->GetPrimaryRing(), ring->GetPrimaryRing(), count);
+	TestRing(ring->GetSecondaryRing(), ring->GetSecondaryRing(), count);
+
+	return HOST_TEST_RESULT();
+}
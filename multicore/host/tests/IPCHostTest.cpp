@@ -0,0 +1,169 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+/**
+	@file
+	@brief Runs the host IPC benchmarks as a smoke test of the simulated cores, FIFOs and ring buffers
+
+	Message counts are kept small so this is quick enough (including under ThreadSanitizer) to run on every build.
+	Pass a message count on the command line for longer runs with meaningful numbers.
+ */
+
+#include "../IPCHostSim.h"
+#include "HostTest.h"
+#include <atomic>
+#include <stdlib.h>
+
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_fifoTxBuf[1024];
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_fifoRxBuf[1024];
+
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_ringTxBuf[4096];
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_ringRxBuf[4096];
+
+static void PrintResult(const char* name, uint32_t msgsize, const IPCHostBenchmarkResult& result)
+{
+	printf("%-16s %5u bytes: %10.0f msg/s, %8.2f MB/s",
+		name, msgsize, result.GetMessageRate(), result.GetThroughput());
+	if(result.m_meanLatency > 0)
+	{
+		printf(", latency min/mean/p99/max %.0f / %.0f / %.0f / %.0f ns",
+			result.m_minLatency, result.m_meanLatency, result.m_p99Latency, result.m_maxLatency);
+	}
+	printf("\n");
+}
+
+/**
+	@brief Checks that both simulated cores actually run, and that IPCHostRunCores() waits for the secondary
+ */
+static void TestRunCores()
+{
+	std::atomic<int> ran(0);
+	IPCHostRunCores(
+		[&] { ran += 1; },
+		[&] { ran += 2; });
+	HOST_CHECK_EQUAL(ran.load(), 3);
+}
+
+/**
+	@brief Checks the channel ID index the secondary resolves channels with
+
+	The host backend is built as the primary core only, so FindChannel() itself isn't built (see IPCHostSim.h). The
+	index it sits on is a header-only template, so test that directly.
+ */
+static void TestChannelIndex()
+{
+	IPCChannelIndex<IPCChannelIndexSize(4)> index;
+	index.Clear();
+
+	HOST_CHECK_EQUAL(index.Lookup(IPCChannelID("log")), -1);
+
+	HOST_CHECK(index.Insert(IPCChannelID("log"), 0));
+	HOST_CHECK(index.Insert(IPCChannelID("rpc"), 1));
+	HOST_CHECK(!index.Insert(IPCChannelID("log"), 2));
+
+	//Same bucket (IDs differ only above the index bits), so the second one has to probe
+	HOST_CHECK(index.Insert(0x1000, 2));
+	HOST_CHECK(index.Insert(0x2000, 3));
+
+	HOST_CHECK_EQUAL(index.Lookup(IPCChannelID("log")), 0);
+	HOST_CHECK_EQUAL(index.Lookup(IPCChannelID("rpc")), 1);
+	HOST_CHECK_EQUAL(index.Lookup(0x1000), 2);
+	HOST_CHECK_EQUAL(index.Lookup(0x2000), 3);
+	HOST_CHECK_EQUAL(index.Lookup(0x3000), -1);
+}
+
+static void TestFifo(IPCDescriptorChannel* chan, uint32_t count)
+{
+	for(uint32_t size : { 8, 64, 1024 })
+	{
+		auto result = IPCHostFifoThroughput(chan, size, count);
+		PrintResult("FIFO throughput", size, result);
+		HOST_CHECK_EQUAL(result.m_messages, count);
+
+		result = IPCHostFifoLatency(chan, size, count);
+		PrintResult("FIFO latency", size, result);
+		HOST_CHECK(result.m_minLatency <= result.m_maxLatency);
+	}
+
+	//Both directions should have been drained
+	HOST_CHECK(!chan->GetPrimaryFifo().Peek());
+	HOST_CHECK(!chan->GetSecondaryFifo().Peek());
+}
+
+static void TestRing(IPCRingChannel* chan, uint32_t count)
+{
+	for(uint32_t size : { 8, 64, 1024 })
+	{
+		auto result = IPCHostRingThroughput(chan, size, count);
+		PrintResult("Ring throughput", size, result);
+		HOST_CHECK_EQUAL(result.m_messages, count);
+
+		result = IPCHostRingLatency(chan, size, count);
+		PrintResult("Ring latency", size, result);
+		HOST_CHECK(result.m_minLatency <= result.m_maxLatency);
+	}
+
+	uint32_t len;
+	HOST_CHECK(chan->GetPrimaryRing().Peek(len) == nullptr);
+	HOST_CHECK(chan->GetSecondaryRing().Peek(len) == nullptr);
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t count = 2000;
+	if(argc > 1)
+		count = strtoul(argv[1], nullptr, 10);
+
+	TestRunCores();
+	TestChannelIndex();
+
+	auto chan = g_ipcDescriptorTable.AllocateChannel(
+		"bench", g_fifoTxBuf, sizeof(g_fifoTxBuf), g_fifoRxBuf, sizeof(g_fifoRxBuf));
+	HOST_CHECK(chan != nullptr);
+	HOST_CHECK(g_ipcDescriptorTable.AllocateChannel(
+		"bench", g_fifoTxBuf, sizeof(g_fifoTxBuf), g_fifoRxBuf, sizeof(g_fifoRxBuf)) == nullptr);
+
+	//Buffers which don't start and end on a cache line are refused, and don't use up a channel
+	HOST_CHECK(g_ipcDescriptorTable.AllocateChannel(
+		"short", g_fifoTxBuf, sizeof(g_fifoTxBuf) - 4, g_fifoRxBuf, sizeof(g_fifoRxBuf)) == nullptr);
+	HOST_CHECK(g_ipcDescriptorTable.AllocateChannel(
+		"offset", g_fifoTxBuf, sizeof(g_fifoTxBuf), g_fifoRxBuf + 32, sizeof(g_fifoRxBuf) - 64) == nullptr);
+	HOST_CHECK(g_ipcDescriptorTable.AllocateRingChannel(
+		"shortring", g_ringTxBuf, sizeof(g_ringTxBuf), g_ringRxBuf, 32) == nullptr);
+	if(chan)
+		TestFifo(chan, count);
+
+	auto ring = g_ipcDescriptorTable.AllocateRingChannel(
+		"benchring", g_ringTxBuf, sizeof(g_ringTxBuf), g_ringRxBuf, sizeof(g_ringRxBuf));
+	HOST_CHECK(ring != nullptr);
+	if(ring)
+		TestRing(ring, count);
+
+	return HOST_TEST_RESULT();
+}
@@ -0,0 +1,164 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+/**
+	@file
+	@brief Tests for IPCInterruptDispatcher, with the test calling the interrupt handlers in place of the IPCC ISRs
+
+	The host backend is built as the primary core, so g_ipcInterruptDispatcher sees the secondary-to-primary FIFOs as
+	RX and the primary-to-secondary FIFOs as TX.
+ */
+
+#include "../IPCHostSim.h"
+#include "../IPCInterruptDispatcher.h"
+#include "HostTest.h"
+
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_txBuf[2][64];
+alignas(IPC_CACHE_LINE_SIZE) static volatile uint8_t g_rxBuf[2][64];
+
+class IdleTask : public Task
+{
+public:
+	IdleTask()
+		: Task(false)
+	{}
+
+	virtual void Iteration() override
+	{}
+};
+
+/**
+	@brief Data arriving on a registered channel wakes its receiver, once, until the receiver re-arms it
+ */
+static void TestRx(IPCDescriptorChannel* chan, IPCDescriptorChannel* other)
+{
+	auto& disp = g_ipcInterruptDispatcher;
+	auto& rx = chan->GetSecondaryFifo();
+	auto channel = rx.GetChannel();
+	uint8_t msg[4] = { 1, 2, 3, 4 };
+	uint8_t buf[64];
+
+	IdleTask receiver;
+	IdleTask unrelated;
+	disp.RegisterReceiver(channel, &receiver);
+	disp.RegisterReceiver(other->GetSecondaryFifo().GetChannel(), &unrelated);
+
+	//Nothing sent yet
+	disp.OnRxInterrupt();
+	HOST_CHECK(!receiver.IsWakePending());
+	HOST_CHECK(!disp.ConsumeRxReady(channel));
+
+	//Peer sends something: receiver (and only the receiver) is woken
+	rx.Push(msg, sizeof(msg));
+	disp.OnRxInterrupt();
+	HOST_CHECK(receiver.ConsumeWakeup());
+	HOST_CHECK(!unrelated.IsWakePending());
+	HOST_CHECK(disp.ConsumeRxReady(channel));
+	HOST_CHECK(!disp.ConsumeRxReady(channel));
+
+	//Channel is masked until re-armed, even though it's still occupied
+	disp.OnRxInterrupt();
+	HOST_CHECK(!receiver.IsWakePending());
+
+	//Re-arming with data still waiting reports it again straight away
+	disp.ArmRx(channel);
+	disp.OnRxInterrupt();
+	HOST_CHECK(receiver.ConsumeWakeup());
+	HOST_CHECK(disp.ConsumeRxReady(channel));
+
+	//Consume it and re-arm: quiet until the next message
+	HOST_CHECK_EQUAL(rx.Pop(buf), sizeof(msg));
+	disp.ArmRx(channel);
+	disp.OnRxInterrupt();
+	HOST_CHECK(!receiver.IsWakePending());
+
+	rx.Push(msg, sizeof(msg));
+	disp.OnRxInterrupt();
+	HOST_CHECK(receiver.ConsumeWakeup());
+	rx.Pop(buf);
+}
+
+/**
+	@brief A sender waiting on a busy channel is woken once the peer drains it, and not again until re-armed
+ */
+static void TestTx(IPCDescriptorChannel* chan)
+{
+	auto& disp = g_ipcInterruptDispatcher;
+	auto& tx = chan->GetPrimaryFifo();
+	auto channel = tx.GetChannel();
+	uint8_t msg[4] = { 1, 2, 3, 4 };
+	uint8_t buf[64];
+
+	IdleTask sender;
+
+	//Not armed: no wakeup even though the channel is free
+	disp.OnTxInterrupt();
+	HOST_CHECK(!sender.IsWakePending());
+
+	//Fill the channel, then wait for it to drain
+	HOST_CHECK(tx.TryPush(msg, sizeof(msg)) == IPC_PUSH_OK);
+	HOST_CHECK(tx.TryPush(msg, sizeof(msg)) == IPC_PUSH_WOULD_BLOCK);
+	disp.ArmTx(channel, &sender);
+	disp.OnTxInterrupt();
+	HOST_CHECK(!sender.IsWakePending());
+	HOST_CHECK(!disp.ConsumeTxReady(channel));
+
+	//Peer drains it
+	HOST_CHECK_EQUAL(tx.Pop(buf), sizeof(msg));
+	disp.OnTxInterrupt();
+	HOST_CHECK(sender.ConsumeWakeup());
+	HOST_CHECK(disp.ConsumeTxReady(channel));
+
+	//One-shot: masked again until the next ArmTx()
+	disp.OnTxInterrupt();
+	HOST_CHECK(!sender.IsWakePending());
+	HOST_CHECK(!disp.ConsumeTxReady(channel));
+
+	//Arming a channel that's already free fires right away, so a drain between a failed push and ArmTx() isn't lost
+	disp.ArmTx(channel, &sender);
+	disp.OnTxInterrupt();
+	HOST_CHECK(sender.ConsumeWakeup());
+	HOST_CHECK(disp.ConsumeTxReady(channel));
+}
+
+int main()
+{
+	g_ipcInterruptDispatcher.Initialize();
+
+	auto a = g_ipcDescriptorTable.AllocateChannel("a", g_txBuf[0], 64, g_rxBuf[0], 64);
+	auto b = g_ipcDescriptorTable.AllocateChannel("b", g_txBuf[1], 64, g_rxBuf[1], 64);
+	HOST_CHECK(a && b);
+	if(!a || !b)
+		return HOST_TEST_RESULT();
+
+	TestRx(a, b);
+	TestTx(a);
+
+	return HOST_TEST_RESULT();
+}
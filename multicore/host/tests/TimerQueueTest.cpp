@@ -0,0 +1,205 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+/**
+	@file
+	@brief Tests for TimerQueue and the TimerTask deadline policies, on simulated time
+ */
+
+#include "../IPCHostSim.h"
+#include "HostTest.h"
+
+/**
+	@brief Timer task that counts how many times it fired, and when
+ */
+class CountingTimer : public TimerTask
+{
+public:
+	CountingTimer(uint32_t initialOffset, uint32_t period, TimerMode mode = TIMER_DELAY)
+		: TimerTask(initialOffset, period, mode)
+		, m_count(0)
+		, m_lastFired(0)
+	{}
+
+	virtual void OnTimer() override
+	{
+		m_count ++;
+		m_lastFired = g_timebase.GetTicks();
+	}
+
+	uint32_t m_count;
+	uint64_t m_lastFired;
+};
+
+/**
+	@brief Advances simulated time one tick at a time up to a deadline, running the queue at each step
+ */
+static void RunUntil(TimerQueue& queue, uint64_t end)
+{
+	while(g_timebase.GetTicks() < end)
+	{
+		IPCHostAdvanceTime(1);
+		queue.RunDueTasks(g_timebase.GetTicks());
+	}
+}
+
+/**
+	@brief Timers with different periods fire in deadline order, the right number of times
+ */
+static void TestOrdering()
+{
+	auto start = g_timebase.GetTicks();
+	CountingTimer fast(10, 10);
+	CountingTimer medium(25, 25);
+	CountingTimer slow(100, 100);
+
+	TimerQueue queue;
+	queue.Add(&slow);
+	queue.Add(&fast);
+	queue.Add(&medium);
+	HOST_CHECK_EQUAL(queue.size(), 3u);
+	HOST_CHECK_EQUAL(queue.GetNextDeadline(), start + 10);
+
+	//Nothing is due yet
+	HOST_CHECK(!queue.RunDueTasks(start + 9));
+	HOST_CHECK_EQUAL(fast.m_count, 0u);
+
+	RunUntil(queue, start + 100);
+	HOST_CHECK_EQUAL(fast.m_count, 10u);
+	HOST_CHECK_EQUAL(medium.m_count, 4u);
+	HOST_CHECK_EQUAL(slow.m_count, 1u);
+	HOST_CHECK_EQUAL(slow.m_lastFired, start + 100);
+	HOST_CHECK_EQUAL(queue.GetNextDeadline(), start + 110);
+}
+
+/**
+	@brief A zero-period timer fires once per call, and doesn't hold up other timers
+ */
+static void TestZeroPeriod()
+{
+	auto start = g_timebase.GetTicks();
+	CountingTimer spin(0, 0);
+	CountingTimer a(5, 100);
+	CountingTimer b(5, 100);
+
+	TimerQueue queue;
+	queue.Add(&spin);
+	queue.Add(&a);
+	queue.Add(&b);
+
+	IPCHostAdvanceTime(5);
+	auto now = g_timebase.GetTicks();
+	for(int i=0; i<4; i++)
+		HOST_CHECK(queue.RunDueTasks(now));
+
+	//The spinning timer gets one go per call, never more
+	HOST_CHECK(spin.m_count <= 4);
+	HOST_CHECK(spin.m_count >= 2);
+	HOST_CHECK_EQUAL(a.m_count, 1u);
+	HOST_CHECK_EQUAL(b.m_count, 1u);
+	HOST_CHECK_EQUAL(a.GetTarget(), start + 105);
+}
+
+/**
+	@brief Restart() moves a timer in the queue
+ */
+static void TestRestart()
+{
+	auto start = g_timebase.GetTicks();
+	CountingTimer a(10, 50);
+	CountingTimer b(20, 50);
+
+	TimerQueue queue;
+	queue.Add(&a);
+	queue.Add(&b);
+	HOST_CHECK_EQUAL(queue.GetNextDeadline(), start + 10);
+
+	//Pushing a back to start + 5 + 50 puts b at the head
+	IPCHostAdvanceTime(5);
+	a.Restart();
+	HOST_CHECK_EQUAL(a.GetTarget(), start + 55);
+	HOST_CHECK_EQUAL(queue.GetNextDeadline(), start + 20);
+
+	RunUntil(queue, start + 54);
+	HOST_CHECK_EQUAL(a.m_count, 0u);
+	HOST_CHECK_EQUAL(b.m_count, 1u);
+
+	RunUntil(queue, start + 55);
+	HOST_CHECK_EQUAL(a.m_count, 1u);
+}
+
+/**
+	@brief Deadline and overrun accounting for each TimerMode when the queue isn't run for a while
+ */
+static void TestModes()
+{
+	auto start = g_timebase.GetTicks();
+	CountingTimer delay(10, 10, TIMER_DELAY);
+	CountingTimer skip(10, 10, TIMER_FIXED_RATE_SKIP);
+	CountingTimer catchup(10, 10, TIMER_FIXED_RATE_CATCHUP);
+
+	TimerQueue queue;
+	queue.Add(&delay);
+	queue.Add(&skip);
+	queue.Add(&catchup);
+
+	//Stall for 3.5 periods
+	IPCHostAdvanceTime(45);
+	auto now = g_timebase.GetTicks();
+
+	//Delay: fires once, and the next deadline is a period after now
+	//Skip: fires once, missed periods dropped and the schedule stays on the original phase
+	//Catch-up: fires once per call until it's back on schedule
+	for(int i=0; i<8; i++)
+		queue.RunDueTasks(now);
+
+	HOST_CHECK_EQUAL(delay.m_count, 1u);
+	HOST_CHECK_EQUAL(delay.GetTarget(), now + 10);
+	HOST_CHECK_EQUAL(delay.GetOverruns(), 1u);
+
+	HOST_CHECK_EQUAL(skip.m_count, 1u);
+	HOST_CHECK_EQUAL(skip.GetTarget(), start + 50);
+	HOST_CHECK_EQUAL(skip.GetOverruns(), 3u);
+
+	HOST_CHECK_EQUAL(catchup.m_count, 4u);
+	HOST_CHECK_EQUAL(catchup.GetTarget(), start + 50);
+	HOST_CHECK_EQUAL(catchup.GetOverruns(), 3u);
+}
+
+int main()
+{
+	IPCHostSetFakeTime(true);
+
+	TestOrdering();
+	TestZeroPeriod();
+	TestRestart();
+	TestModes();
+
+	return HOST_TEST_RESULT();
+}
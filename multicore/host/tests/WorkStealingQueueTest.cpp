@@ -0,0 +1,226 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+/**
+	@file
+	@brief Tests for WorkStealingQueue, including migration of tasks between threads standing in for cores
+ */
+
+#include "../IPCHostSim.h"
+#include "HostTest.h"
+#include <atomic>
+#include <memory>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+/**
+	@brief Task that counts its runs, and flags any run that overlaps another one
+ */
+class CountingTask : public Task
+{
+public:
+	CountingTask(bool alwaysReady = true)
+		: Task(alwaysReady)
+		, m_runs(0)
+		, m_running(false)
+		, m_overlaps(0)
+	{ SetAffinity(AFFINITY_ANY); }
+
+	virtual void Iteration() override
+	{
+		if(m_running.exchange(true))
+			m_overlaps ++;
+		m_runs ++;
+		m_running = false;
+	}
+
+	std::atomic<uint32_t> m_runs;
+	std::atomic<bool> m_running;
+	std::atomic<uint32_t> m_overlaps;
+};
+
+/**
+	@brief Push and Steal on one thread: FIFO order, empty and full behavior
+ */
+static void TestSingleThread()
+{
+	auto queue = std::make_unique<WorkStealingQueue>();
+	CountingTask tasks[WORK_QUEUE_SIZE + 1];
+
+	HOST_CHECK(queue->Steal() == nullptr);
+
+	for(uint32_t i=0; i<WORK_QUEUE_SIZE; i++)
+		HOST_CHECK(queue->Push(&tasks[i]));
+	HOST_CHECK(!queue->Push(&tasks[WORK_QUEUE_SIZE]));
+	HOST_CHECK_EQUAL(queue->size(), WORK_QUEUE_SIZE);
+
+	for(uint32_t i=0; i<WORK_QUEUE_SIZE; i++)
+		HOST_CHECK(queue->Steal() == &tasks[i]);
+	HOST_CHECK(queue->Steal() == nullptr);
+	HOST_CHECK_EQUAL(queue->size(), 0u);
+}
+
+/**
+	@brief Dispatch() runs every queued task that's ready, once, and keeps them all queued
+ */
+static void TestDispatch()
+{
+	auto& queue = g_workQueues[0];
+	CountingTask polled;
+	CountingTask idle(false);
+	CountingTask woken(false);
+	woken.Wake();
+
+	etl::vector<Task*, MAX_TASKS> tasks;
+	tasks.push_back(&polled);
+	tasks.push_back(&idle);
+	tasks.push_back(&woken);
+	queue.Initialize(tasks);
+	HOST_CHECK_EQUAL(queue.size(), 3u);
+
+	HOST_CHECK(queue.Dispatch(0));
+	HOST_CHECK_EQUAL(polled.m_runs.load(), 1u);
+	HOST_CHECK_EQUAL(idle.m_runs.load(), 0u);
+	HOST_CHECK_EQUAL(woken.m_runs.load(), 1u);
+	HOST_CHECK_EQUAL(queue.size(), 3u);
+
+	HOST_CHECK(queue.Dispatch(0));
+	HOST_CHECK_EQUAL(polled.m_runs.load(), 2u);
+	HOST_CHECK_EQUAL(woken.m_runs.load(), 1u);
+
+	while(queue.Steal())
+	{}
+}
+
+/**
+	@brief Several threads, each owning a queue, running their own tasks and stealing from each other
+
+	Follows the same protocol as Dispatch(): take a task from the top of a queue, run it, push it onto your own. Every
+	task must end up in exactly one queue, and no task may ever run on two threads at once.
+ */
+static void TestMigration(uint32_t iterations)
+{
+	const uint32_t nthreads = 4;
+	const uint32_t ntasks = WORK_QUEUE_SIZE;
+
+	std::vector<std::unique_ptr<WorkStealingQueue>> queues;
+	for(uint32_t i=0; i<nthreads; i++)
+		queues.push_back(std::make_unique<WorkStealingQueue>());
+
+	//Start with all of the tasks on one thread, so the others have to steal
+	std::vector<std::unique_ptr<CountingTask>> tasks;
+	for(uint32_t i=0; i<ntasks; i++)
+	{
+		tasks.push_back(std::make_unique<CountingTask>());
+		queues[0]->Push(tasks.back().get());
+	}
+
+	std::atomic<uint32_t> steals(0);
+	std::vector<std::thread> threads;
+	for(uint32_t self=0; self<nthreads; self++)
+	{
+		threads.emplace_back([&, self]
+		{
+			for(uint32_t i=0; i<iterations; i++)
+			{
+				//Mostly run our own tasks, but regularly raid another thread's queue even if we have work
+				auto& victim = queues[(self + 1 + i % (nthreads - 1)) % nthreads];
+				Task* t = nullptr;
+				if( (i % 4) == 0)
+					t = victim->Steal();
+				if(t)
+					steals ++;
+				else
+					t = queues[self]->Steal();
+				if(!t)
+				{
+					t = victim->Steal();
+					if(t)
+						steals ++;
+				}
+				if(!t)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				t->Run();
+
+				//Can't fail: there are only as many tasks as slots in one queue
+				if(!queues[self]->Push(t))
+					printf("Push failed\n");
+			}
+		});
+	}
+	for(auto& t : threads)
+		t.join();
+
+	//Every task is still in exactly one queue
+	std::vector<int> seen(ntasks, 0);
+	uint32_t found = 0;
+	for(auto& q : queues)
+	{
+		Task* t;
+		while( (t = q->Steal()) != nullptr)
+		{
+			for(uint32_t i=0; i<ntasks; i++)
+			{
+				if(t == tasks[i].get())
+					seen[i] ++;
+			}
+			found ++;
+		}
+	}
+	HOST_CHECK_EQUAL(found, ntasks);
+
+	uint64_t runs = 0;
+	for(uint32_t i=0; i<ntasks; i++)
+	{
+		HOST_CHECK_EQUAL(seen[i], 1);
+		HOST_CHECK_EQUAL(tasks[i]->m_overlaps.load(), 0u);
+		runs += tasks[i]->m_runs;
+	}
+	HOST_CHECK(runs > 0);
+	HOST_CHECK(steals > 0);
+	printf("%llu task runs, %u steals\n", (unsigned long long)runs, steals.load());
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t iterations = 20000;
+	if(argc > 1)
+		iterations = strtoul(argv[1], nullptr, 10);
+
+	TestSingleThread();
+	TestDispatch();
+	TestMigration(iterations);
+
+	return HOST_TEST_RESULT();
+}
@@ -36,10 +36,16 @@
 #include <stm32.h>
 #include <peripheral/RTC.h>
 
+///@brief Set to verbose to trace the control connection state machine
+static LogCategory g_iperfLog("iperf", LOG_LEVEL_NOTICE);
+
 Iperf3Server::Iperf3Server(TCPProtocol& tcp, UDPProtocol& udp)
 	: TCPServer(tcp)
+	, Task(false, PRIORITY_REALTIME)
 	, m_udp(udp)
 {
+	//We only have work to do while a test is running, so don't get polled when idle.
+	//When we do, we're on the packet path so get revisited between other tasks.
 	//Register ourselves automatically in the task table
 	g_tasks.push_back(this);
 }
@@ -68,7 +74,10 @@ void Iperf3Server::OnConnectionClosed(TCPTableEntry* socket)
 	//Connection was terminated by the other end, close our state so we can reuse it
 	auto id = GetConnectionID(socket);
 	if(id >= 0)
+	{
+		CloseStream(id);
 		m_state[id].Clear();
+	}
 }
 
 /**
@@ -81,6 +90,15 @@ bool Iperf3Server::OnRxData(TCPTableEntry* socket, uint8_t* payload, uint16_t pa
 	if(id < 0)
 		return true;
 
+	//TCP data streams carry nothing but test payload, just count it
+	if(m_state[id].m_state == IperfConnectionState::DATA_STREAM)
+	{
+		auto cid = m_state[id].m_controlID;
+		if(cid >= 0)
+			m_state[cid].m_bytes += payloadLen;
+		return true;
+	}
+
 	//Push the segment data into our RX FIFO
 	if(!m_state[id].m_rxBuffer.Push(payload, payloadLen))
 	{
@@ -126,6 +144,13 @@ bool Iperf3Server::OnRxData(TCPTableEntry* socket, uint8_t* payload, uint16_t pa
 					return true;
 				return true;
 
+			//Cookie turned out to be for a TCP data stream, anything after it is test payload
+			case IperfConnectionState::DATA_STREAM:
+				if(m_state[id].m_controlID >= 0)
+					m_state[m_state[id].m_controlID].m_bytes += m_state[id].m_rxBuffer.ReadSize();
+				m_state[id].m_rxBuffer.Reset();
+				return true;
+
 			//unknown state, stop
 			default:
 				return false;
@@ -181,6 +206,7 @@ void Iperf3Server::OnRxUdpData(
 		m_state[i].m_clientPort = sport;
 		m_state[i].m_state = IperfConnectionState::TEST_START;
 		SendState(i, m_state[i].m_socket);
+		Wake();
 		break;
 	}
 }
@@ -190,6 +216,7 @@ void Iperf3Server::OnRxUdpData(
  */
 void Iperf3Server::GracefulDisconnect([[maybe_unused]] int id, [[maybe_unused]] TCPTableEntry* socket)
 {
+	CloseStream(id);
 	m_state[id].Clear();
 	m_tcp.CloseSocket(socket);
 }
@@ -199,10 +226,32 @@ void Iperf3Server::GracefulDisconnect([[maybe_unused]] int id, [[maybe_unused]]
  */
 void Iperf3Server::DropConnection(int id, TCPTableEntry* socket)
 {
+	CloseStream(id);
 	m_state[id].Clear();
 	m_tcp.CloseSocket(socket);
 }
 
+/**
+	@brief Breaks the link between a control connection and its TCP data stream, when either one goes away
+
+	If id is a control connection, its data stream is closed too since it's of no use without it.
+ */
+void Iperf3Server::CloseStream(int id)
+{
+	auto& state = m_state[id];
+
+	if(state.m_controlID >= 0)
+		m_state[state.m_controlID].m_streamID = -1;
+
+	else if(state.m_streamID >= 0)
+	{
+		auto& stream = m_state[state.m_streamID];
+		auto socket = stream.m_socket;
+		stream.Clear();
+		m_tcp.CloseSocket(socket);
+	}
+}
+
 /**
 	@brief Sends the current state to the client
  */
@@ -231,15 +280,62 @@ bool Iperf3Server::OnRxCookie(int id, TCPTableEntry* socket)
 	//All good, read the cookie
 	auto p = fifo.Rewind();
 	memcpy(m_state[id].m_cookie, p, IPERF_COOKIE_SIZE);
-	g_log("Iperf3 client connected (cookie=%s)\n", m_state[id].m_cookie);
 	fifo.Pop(IPERF_COOKIE_SIZE);
 
+	//If a TCP mode control connection with the same cookie is waiting for its streams, this is the data stream
+	for(int i=0; i<MAX_IPERF_CLIENTS; i++)
+	{
+		auto& control = m_state[i];
+		if( (i == id) || !control.m_valid)
+			continue;
+		if( (control.m_state != IperfConnectionState::CREATE_STREAMS) ||
+			(control.m_mode != IperfConnectionState::MODE_TCP) )
+		{
+			continue;
+		}
+		if(0 != memcmp(control.m_cookie, m_state[id].m_cookie, IPERF_COOKIE_SIZE))
+			continue;
+
+		g_log("Stream opened (TCP)\n");
+		m_state[id].m_state = IperfConnectionState::DATA_STREAM;
+		m_state[id].m_controlID = i;
+		control.m_streamID = id;
+
+		//Start the test (same as UDP: TEST_START now, TEST_RUNNING from Iteration())
+		control.m_state = IperfConnectionState::TEST_START;
+		SendState(i, control.m_socket);
+		Wake();
+		return true;
+	}
+
+	g_log("Iperf3 client connected (cookie=%s)\n", m_state[id].m_cookie);
+
 	//Exchanging parameters
 	m_state[id].m_state = IperfConnectionState::PARAM_EXCHANGE;
 	SendState(id, socket);
 	return true;
 }
 
+/**
+	@brief Formats an unsigned 64-bit value in decimal
+
+	@param buf		Output buffer, at least 21 bytes
+ */
+static void FormatDecimal64(char* buf, uint64_t value)
+{
+	char digits[20];
+	uint32_t n = 0;
+	do
+	{
+		digits[n++] = '0' + (value % 10);
+		value /= 10;
+	} while(value);
+
+	for(uint32_t i=0; i<n; i++)
+		buf[i] = digits[n - 1 - i];
+	buf[n] = '\0';
+}
+
 bool Iperf3Server::OnRxEnd(int id, TCPTableEntry* socket)
 {
 	auto& fifo = m_state[id].m_rxBuffer;
@@ -254,7 +350,7 @@ bool Iperf3Server::OnRxEnd(int id, TCPTableEntry* socket)
 	}
 
 	//All done, now in EXCHANGE_RESULTS state
-	//g_log("Got END command from client\n");
+	LOG_VERBOSE(g_iperfLog, "Got END command from client\n");
 	fifo.Pop(1);
 
 	//Exchange results
@@ -267,6 +363,12 @@ bool Iperf3Server::OnRxEnd(int id, TCPTableEntry* socket)
 		return false;
 	auto payload = segment->Payload();
 
+	//Printf has no 64-bit conversions
+	uint64_t bytes = (m_state[id].m_mode == IperfConnectionState::MODE_TCP) ?
+		m_state[id].m_bytes : static_cast<uint64_t>(m_state[id].m_sequence) * m_state[id].m_len;
+	char bytesText[21];
+	FormatDecimal64(bytesText, bytes);
+
 	StringBuffer buf((char*)payload+4, 1400);
 	buf.Printf(
 		"{"
@@ -276,7 +378,7 @@ bool Iperf3Server::OnRxEnd(int id, TCPTableEntry* socket)
 		"\"sender_has_retransmits\":0,"
 		"\"streams\":[{"
 		"\"id\":1,"
-		"\"bytes\":%u,"
+		"\"bytes\":%s,"
 		"\"retransmits\":18446744073709551615,"	// -1 casted to an unsigned int64, yes this is what iperf expects
 		"\"jitter\":0.0,"
 		"\"errors\":0.0,"
@@ -284,7 +386,7 @@ bool Iperf3Server::OnRxEnd(int id, TCPTableEntry* socket)
 		"\"start_time\":0,"
 		"\"end_time\":%d.%d"
 		"}]}",
-		m_state[id].m_sequence * m_state[id].m_len,
+		bytesText,
 		m_state[id].m_sequence,
 
 		//TODO: actual measured elapsed sending time?
@@ -422,30 +524,26 @@ bool Iperf3Server::OnRxParamExchange(int id, TCPTableEntry* socket)
 	m_state[id].m_state = IperfConnectionState::CREATE_STREAMS;
 	SendState(id, socket);
 
-	//Validate that we're in UDP mode
-	if(m_state[id].m_mode != IperfConnectionState::MODE_UDP)
-	{
-		g_log(Logger::WARNING, "TCP mode not yet supported\n");
-		DropConnection(id, socket);
-		return true;
-	}
-
-	//Validate that we're in reverse mode
-	if(m_state[id].m_reverseMode != true)
+	//TCP mode works in either direction, and segment size is up to us rather than the block length
+	if(m_state[id].m_mode == IperfConnectionState::MODE_UDP)
 	{
-		g_log(Logger::WARNING, "Only reverse mode supported right now\n");
-		DropConnection(id, socket);
-		return true;
-	}
+		//Validate that we're in reverse mode
+		if(m_state[id].m_reverseMode != true)
+		{
+			g_log(Logger::WARNING, "Only reverse mode supported for UDP right now\n");
+			DropConnection(id, socket);
+			return true;
+		}
 
-	if(m_state[id].m_len >= 1480)
-	{
-		g_log(Logger::WARNING, "Requested block length is too big (we don't support IP fragmentation)\n");
-		DropConnection(id, socket);
-		return true;
+		if(m_state[id].m_len >= 1480)
+		{
+			g_log(Logger::WARNING, "Requested block length is too big (we don't support IP fragmentation)\n");
+			DropConnection(id, socket);
+			return true;
+		}
 	}
 
-	//g_log("Setup done, asking client to open streams\n");
+	LOG_VERBOSE(g_iperfLog, "Setup done, asking client to open streams\n");
 
 	return true;
 }
@@ -526,7 +624,37 @@ void Iperf3Server::Iteration()
 	for(size_t i=0; i<MAX_IPERF_CLIENTS; i++)
 	{
 		if(!m_state[i].m_valid)
-			return;
+			continue;
+
+		//TCP mode: tell the client we're running, then keep the data stream's window full if we're the sender
+		if(m_state[i].m_mode == IperfConnectionState::MODE_TCP)
+		{
+			switch(m_state[i].m_state)
+			{
+				case IperfConnectionState::TEST_START:
+					m_state[i].m_state = IperfConnectionState::TEST_RUNNING;
+					SendState(i, m_state[i].m_socket);
+					if(m_state[i].m_reverseMode && (m_state[i].m_streamID >= 0) )
+					{
+						SendDataOnTCPStream(i);
+						Wake();
+					}
+					break;
+
+				//Stop polling once the data stream is gone, the client will end the test
+				case IperfConnectionState::TEST_RUNNING:
+					if(m_state[i].m_reverseMode && (m_state[i].m_streamID >= 0) )
+					{
+						SendDataOnTCPStream(i);
+						Wake();
+					}
+					break;
+
+				default:
+					break;
+			}
+			continue;
+		}
 
 		//If we're in START state, send a single packet then go to RUNNING state
 		switch(m_state[i].m_state)
@@ -535,10 +663,13 @@ void Iperf3Server::Iteration()
 				SendDataOnStream(i, m_state[i].m_socket);
 				m_state[i].m_state = IperfConnectionState::TEST_RUNNING;
 				SendState(i, m_state[i].m_socket);
+				Wake();
 				break;
 
+			//Keep ourselves scheduled until the client ends the test
 			case IperfConnectionState::TEST_RUNNING:
 				SendDataOnStream(i, m_state[i].m_socket);
+				Wake();
 				break;
 
 			default:
@@ -547,6 +678,34 @@ void Iperf3Server::Iteration()
 	}
 }
 
+/**
+	@brief Sends test data on the TCP data stream of control connection id, until the stack can't take any more
+
+	GetTxSegment() fails once the send window (or the stack's buffers) are full, so this keeps as much data in flight
+	as the TCP stack allows. We're called again on the next pass through the main loop to top it back up.
+ */
+#ifdef HAVE_ITCM
+__attribute__((section(".tcmtext")))
+#endif
+void Iperf3Server::SendDataOnTCPStream(int id)
+{
+	auto sid = m_state[id].m_streamID;
+	if(sid < 0)
+		return;
+	auto socket = m_state[sid].m_socket;
+
+	while(true)
+	{
+		auto segment = m_tcp.GetTxSegment(socket);
+		if(!segment)
+			break;
+
+		FillPacket(id, reinterpret_cast<uint32_t*>(segment->Payload()), IPERF_TCP_SEGMENT_SIZE);
+		m_tcp.SendTxSegment(socket, segment, IPERF_TCP_SEGMENT_SIZE);
+		m_state[id].m_bytes += IPERF_TCP_SEGMENT_SIZE;
+	}
+}
+
 #ifdef HAVE_ITCM
 __attribute__((section(".tcmtext")))
 #endif
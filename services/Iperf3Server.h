@@ -31,10 +31,13 @@
 	@file
 	@brief Embedded network benchmark compatible with a subset of the iperf version 3 protocol
 
-	For now, only supports TCP reverse connection mode for outbound bandwidth benchmarks on the embedded DUT,
-	with no bandwidth limit.
+	Supports one stream, with no bandwidth limit, in either:
+	* UDP reverse mode, for outbound bandwidth benchmarks on the embedded DUT
+	  (clientside test command: iperf3 -c $ip -u -R -l 1024)
+	* TCP mode in either direction, to benchmark the TCP stack itself
+	  (clientside test command: iperf3 -c $ip [-R])
 
-	Clientside test command: iperf3 -c $ip -u -R -l 1024
+	A TCP test uses two connections (control and data), so MAX_IPERF_CLIENTS must be at least 2.
  */
 #ifndef Iperf3Server_h
 #define Iperf3Server_h
@@ -44,8 +47,14 @@
 
 #define IPERF_COOKIE_SIZE 37
 
+///@brief Number of TCP connections (a TCP mode test needs two)
 #ifndef MAX_IPERF_CLIENTS
-#define MAX_IPERF_CLIENTS 1
+#define MAX_IPERF_CLIENTS 2
+#endif
+
+///@brief Payload size of each segment sent on a TCP data stream (Ethernet MTU minus IPv4 and TCP headers)
+#ifndef IPERF_TCP_SEGMENT_SIZE
+#define IPERF_TCP_SEGMENT_SIZE 1460
 #endif
 
 #define IPERF3_PORT	5201
@@ -72,6 +81,9 @@ public:
 		m_reverseMode = false;
 		m_clientPort = 0;
 		m_sequence = 0;
+		m_bytes = 0;
+		m_streamID = -1;
+		m_controlID = -1;
 		m_rxBuffer.Reset();
 	}
 
@@ -86,7 +98,10 @@ public:
 		TEST_END			= 4,
 		EXCHANGE_RESULTS	= 13,
 		DISPLAY_RESULTS		= 14,
-		IPERF_DONE			= 16
+		IPERF_DONE			= 16,
+
+		//Not part of the protocol: this connection is a TCP data stream belonging to m_controlID
+		DATA_STREAM			= 128
 	} m_state;
 
 	///@brief True if the connection is valid
@@ -114,6 +129,15 @@ public:
 	bool m_reverseMode;
 	uint16_t m_clientPort;
 	uint32_t m_sequence;
+
+	///@brief Bytes sent or received on the TCP data stream (64 bits, since a 10G test wraps 32 bits in under 4 seconds)
+	uint64_t m_bytes;
+
+	///@brief Connection ID of our TCP data stream, if any (control connections only)
+	int m_streamID;
+
+	///@brief Connection ID of the control connection we belong to (data streams only)
+	int m_controlID;
 };
 
 class Iperf3Server
@@ -139,6 +163,8 @@ protected:
 	void SendState(int id, TCPTableEntry* socket);
 
 	void SendDataOnStream(int id, TCPTableEntry* socket);
+	void SendDataOnTCPStream(int id);
+	void CloseStream(int id);
 
 	bool OnRxCookie(int id, TCPTableEntry* socket);
 	bool OnRxParamExchange(int id, TCPTableEntry* socket);
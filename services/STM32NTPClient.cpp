@@ -60,10 +60,10 @@ STM32NTPClient::STM32NTPClient(UDPProtocol* udp)
 uint64_t STM32NTPClient::GetLocalTimestamp()
 {
 	//TODO: use the RTC or a dedicated timer
-	//for now just use the log timer
-	uint64_t tnow = g_logTimer.GetCount();
+	//for now just use the monotonic timebase (built on the log timer, so it doesn't jump back on rebase)
+	uint64_t tnow = g_timebase.GetTicks();
 
-	//RTC is 100us steps, convert to native NTP units (2^-32 sec)
+	//Timebase is 100us steps, convert to native NTP units (2^-32 sec)
 	return tnow * 429497;
 }
 
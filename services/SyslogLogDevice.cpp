@@ -0,0 +1,310 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+#include <core/platform.h>
+#include <embedded-utils/StringBuffer.h>
+#include "SyslogLogDevice.h"
+
+///@brief KVS key for syslog enable state
+static const char* g_syslogEnableObjectID = "syslog.enable";
+
+///@brief KVS key for syslog server IP
+static const char* g_syslogServerObjectID = "syslog.server";
+
+///@brief Priority of every message: facility local0, severity informational
+static const char* g_syslogPriority = "<134>";
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction / destruction
+
+SyslogLogDevice::SyslogLogDevice(UDPProtocol* udp, CharacterDevice* fallback)
+	: TimerTask(SYSLOG_FLUSH_PERIOD, SYSLOG_FLUSH_PERIOD, TIMER_FIXED_RATE_SKIP)
+	, m_udp(udp)
+	, m_fallback(fallback)
+	, m_enabled(false)
+	, m_serverAddress(g_defaultSyslogServer)
+	, m_tag("firmware")
+	, m_head(0)
+	, m_tail(0)
+	, m_lastHead(0)
+	, m_drops(0)
+	, m_reportedDrops(0)
+	, m_dropPosition(0)
+	, m_packets(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Serialization
+
+void SyslogLogDevice::LoadConfigFromKVS()
+{
+	m_enabled = g_kvs->ReadObject(g_syslogEnableObjectID, false);
+	m_serverAddress = g_kvs->ReadObject<IPv4Address>(g_defaultSyslogServer, g_syslogServerObjectID);
+}
+
+void SyslogLogDevice::SaveConfigToKVS()
+{
+	if(!g_kvs->StoreObjectIfNecessary(g_syslogEnableObjectID, m_enabled, false))
+		g_log(Logger::ERROR, "KVS write error\n");
+
+	if(!g_kvs->StoreObjectIfNecessary<IPv4Address>(m_serverAddress, g_defaultSyslogServer, g_syslogServerObjectID))
+		g_log(Logger::ERROR, "KVS write error\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Logging
+
+/**
+	@brief Adds log data to the send buffer, or passes it straight to the fallback device if the network is down
+ */
+void SyslogLogDevice::Write(const char* buf, uint32_t len)
+{
+	if(!IsNetworkUp() && m_fallback)
+	{
+		//Keep output in order if the link just went down with data still buffered
+		DrainToFallback();
+		for(uint32_t i=0; i<len; i++)
+			m_fallback->PrintBinary(buf[i]);
+		return;
+	}
+
+	//The timer may be sending from the buffer, and log calls can come from interrupts
+	InterruptGuard guard;
+
+	uint32_t space = SYSLOG_BUFFER_SIZE - (m_head - m_tail);
+	if(len > space)
+	{
+		//Remember where the first unreported gap is, so the notice goes in the right place
+		if(m_drops == m_reportedDrops)
+			m_dropPosition = m_head + space;
+
+		m_drops += len - space;
+		len = space;
+	}
+
+	//Copy in up to two pieces, if we wrap
+	uint32_t offset = m_head & (SYSLOG_BUFFER_SIZE - 1);
+	uint32_t first = SYSLOG_BUFFER_SIZE - offset;
+	if(first > len)
+		first = len;
+	memcpy(m_buffer + offset, buf, first);
+	memcpy(m_buffer, buf + first, len - first);
+	m_head += len;
+}
+
+void SyslogLogDevice::PrintBinary(char ch)
+{
+	Write(&ch, 1);
+}
+
+void SyslogLogDevice::PrintString(const char* str)
+{
+	Write(str, strlen(str));
+}
+
+///@brief Not supported, this is an output-only device
+char SyslogLogDevice::BlockingRead()
+{
+	return 0;
+}
+
+void SyslogLogDevice::Flush()
+{
+	if(!IsNetworkUp() && m_fallback)
+	{
+		DrainToFallback();
+		m_fallback->Flush();
+	}
+}
+
+///@brief Moves everything in the buffer to the fallback device
+void SyslogLogDevice::DrainToFallback()
+{
+	while(m_tail != m_head)
+	{
+		m_fallback->PrintBinary(Peek(0));
+		m_tail ++;
+	}
+
+	//Any gap has been passed over, don't report it later
+	m_reportedDrops = m_drops;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Sending
+
+void SyslogLogDevice::OnTimer()
+{
+	if(!IsNetworkUp())
+	{
+		if(m_fallback)
+			DrainToFallback();
+	}
+
+	else
+	{
+		//If nothing was written since last time, whatever partial line is left has been waiting long enough
+		bool sendPartial = (m_head == m_lastHead);
+
+		for(uint32_t i=0; i<SYSLOG_MAX_PACKETS_PER_PERIOD; i++)
+		{
+			if(!SendPacket(sendPartial))
+				break;
+		}
+	}
+
+	m_lastHead = m_head;
+}
+
+/**
+	@brief Adds one message, with its syslog header, to a datagram
+
+	@param payload	Datagram payload
+	@param offset	Current length of the payload
+	@param prefix	Text to put after the header (may be null), e.g. a drop notice
+	@param maxlen	Most bytes to take from the buffer
+
+	@return New length of the payload
+ */
+uint32_t SyslogLogDevice::AppendRecord(uint8_t* payload, uint32_t offset, const char* prefix, uint32_t maxlen)
+{
+	auto out = reinterpret_cast<char*>(payload);
+
+	uint32_t n = strlen(g_syslogPriority);
+	memcpy(out + offset, g_syslogPriority, n);
+	offset += n;
+
+	n = strlen(m_tag);
+	memcpy(out + offset, m_tag, n);
+	offset += n;
+	out[offset++] = ':';
+	out[offset++] = ' ';
+
+	if(prefix)
+	{
+		n = strlen(prefix);
+		memcpy(out + offset, prefix, n);
+		offset += n;
+	}
+
+	//Copy the line, consuming it from the buffer
+	char c = '\0';
+	for(uint32_t i=0; i<maxlen; i++)
+	{
+		c = Peek(0);
+		out[offset++] = c;
+		m_tail ++;
+	}
+
+	//Every record ends with a newline, even if we had to split the line
+	if(c != '\n')
+		out[offset++] = '\n';
+
+	return offset;
+}
+
+/**
+	@brief Sends one datagram's worth of buffered log lines
+
+	@param sendPartial	True to send a trailing line without a newline
+
+	@return True if a datagram was sent
+ */
+bool SyslogLogDevice::SendPacket(bool sendPartial)
+{
+	//Header for each record, plus room for a newline if we have to add one
+	const uint32_t overhead = strlen(g_syslogPriority) + strlen(m_tag) + 3;
+
+	//Find out how much is worth sending before asking for a packet, since we can't give one back
+	uint32_t avail = m_head - m_tail;
+	uint32_t sendable = 0;
+	for(uint32_t i=0; i<avail; i++)
+	{
+		if(Peek(i) == '\n')
+			sendable = i + 1;
+	}
+	if(sendPartial)
+		sendable = avail;
+
+	//If data was dropped, everything up to the gap is sendable (even a partial line, since the gap ends it) and then
+	//the drop notice goes out, but nothing after it yet
+	bool dropPending = (m_drops != m_reportedDrops);
+	if(dropPending)
+		sendable = m_dropPosition - m_tail;
+
+	if( (sendable == 0) && !dropPending)
+		return false;
+
+	auto upack = m_udp->GetTxPacket(m_serverAddress);
+	if(!upack)
+		return false;
+	auto payload = upack->Payload();
+	uint32_t len = 0;
+
+	//Pack as many whole lines as will fit
+	while(sendable > 0)
+	{
+		uint32_t linelen = 0;
+		while( (linelen < sendable) && (Peek(linelen) != '\n') )
+			linelen ++;
+		if(linelen < sendable)
+			linelen ++;
+
+		uint32_t room = SYSLOG_MAX_PAYLOAD - len;
+		if(room <= overhead)
+			break;
+		room -= overhead;
+
+		//Split lines too long to ever fit, but otherwise leave the line for the next datagram
+		if(linelen > room)
+		{
+			if(len != 0)
+				break;
+			linelen = room;
+		}
+
+		len = AppendRecord(payload, len, nullptr, linelen);
+		sendable -= linelen;
+	}
+
+	//Let the collector know there's a gap in the log
+	if(dropPending && (sendable == 0) && (SYSLOG_MAX_PAYLOAD - len > overhead + 48) )
+	{
+		char notice[48] = {0};
+		StringBuffer buf(notice, sizeof(notice) - 1);
+		buf.Printf("[%u bytes of log output dropped]", m_drops - m_reportedDrops);
+		m_reportedDrops = m_drops;
+		len = AppendRecord(payload, len, notice, 0);
+	}
+
+	m_udp->SendTxPacket(upack, SYSLOG_PORT, SYSLOG_PORT, len);
+	m_packets ++;
+	return true;
+}
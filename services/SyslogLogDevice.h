@@ -0,0 +1,187 @@
+/***********************************************************************************************************************
+*                                                                                                                      *
+* common-embedded-platform                                                                                             *
+*                                                                                                                      *
+* Copyright (c) 2026 Andrew D. Zonenberg and contributors                                                              *
+* All rights reserved.                                                                                                 *
+*                                                                                                                      *
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that the     *
+* following conditions are met:                                                                                        *
+*                                                                                                                      *
+*    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the         *
+*      following disclaimer.                                                                                           *
+*                                                                                                                      *
+*    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       *
+*      following disclaimer in the documentation and/or other materials provided with the distribution.                *
+*                                                                                                                      *
+*    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products     *
+*      derived from this software without specific prior written permission.                                           *
+*                                                                                                                      *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED   *
+* TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL *
+* THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES        *
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR       *
+* BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT *
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE       *
+* POSSIBILITY OF SUCH DAMAGE.                                                                                          *
+*                                                                                                                      *
+***********************************************************************************************************************/
+
+/**
+	@file
+	@brief Log device which streams log output to a syslog server over UDP
+ */
+#ifndef SyslogLogDevice_h
+#define SyslogLogDevice_h
+
+#include <staticnet-config.h>
+#include <staticnet/stack/staticnet.h>
+#include "../tcpip/CommonTCPIP.h"
+
+///@brief Size of the buffer holding log data waiting to be sent
+#ifndef SYSLOG_BUFFER_SIZE
+#define SYSLOG_BUFFER_SIZE 4096
+#endif
+
+static_assert( (SYSLOG_BUFFER_SIZE & (SYSLOG_BUFFER_SIZE - 1)) == 0, "SYSLOG_BUFFER_SIZE must be a power of two");
+
+///@brief Largest UDP payload we send (must fit in one Ethernet frame, we don't support IP fragmentation)
+#ifndef SYSLOG_MAX_PAYLOAD
+#define SYSLOG_MAX_PAYLOAD 1024
+#endif
+
+///@brief Interval between checks for data to send, in log timer ticks (default 10 ms)
+#ifndef SYSLOG_FLUSH_PERIOD
+#define SYSLOG_FLUSH_PERIOD 100
+#endif
+
+///@brief Rate limit: most datagrams sent per SYSLOG_FLUSH_PERIOD
+#ifndef SYSLOG_MAX_PACKETS_PER_PERIOD
+#define SYSLOG_MAX_PACKETS_PER_PERIOD 4
+#endif
+
+#define SYSLOG_PORT 514
+
+/**
+	@brief Log device which batches log lines into RFC 3164 syslog datagrams
+
+	Log output is copied into a RAM buffer, and every SYSLOG_FLUSH_PERIOD the timer sends as many complete lines as fit
+	in each datagram, up to SYSLOG_MAX_PACKETS_PER_PERIOD datagrams. Each line gets its own "<PRI>tag: " header and is
+	newline terminated, so collectors which split datagrams on newlines see one message per line. A partial line is
+	only sent once it has been sitting in the buffer for a whole period with nothing added. If the buffer fills up (the
+	rate limit can't keep up, or ARP hasn't resolved the server yet) new data is dropped, and a message saying how much
+	was lost is sent in its place once the data before it has gone out.
+
+	While the link is down (g_basetLinkUp) or syslog is disabled, output goes straight to the fallback device,
+	typically the console UART, along with anything still buffered. So the device can replace the UART as the
+	primary log sink:
+	@code
+	static SyslogLogDevice syslog(&g_udp, &g_cliUART);
+	static LogSink<MAX_LOG_SINKS> sink(&syslog);
+	...
+	g_timerTasks.push_back(&syslog);
+	g_tasks.push_back(&syslog);
+	@endcode
+
+	Configuration is stored in the KVS as syslog.enable and syslog.server.
+ */
+class SyslogLogDevice
+	: public CharacterDevice
+	, public TimerTask
+{
+public:
+	SyslogLogDevice(UDPProtocol* udp, CharacterDevice* fallback = nullptr);
+
+	void LoadConfigFromKVS();
+	void SaveConfigToKVS();
+
+	void Enable()
+	{ m_enabled = true; }
+
+	void Disable()
+	{ m_enabled = false; }
+
+	bool IsEnabled() const
+	{ return m_enabled; }
+
+	void SetServer(IPv4Address addr)
+	{ m_serverAddress = addr; }
+
+	IPv4Address GetServer() const
+	{ return m_serverAddress; }
+
+	///@brief Sets the tag sent before each message (must stay valid, typically a string literal)
+	void SetTag(const char* tag)
+	{ m_tag = tag; }
+
+	///@brief Number of datagrams sent
+	uint32_t GetPacketCount() const
+	{ return m_packets; }
+
+	///@brief Number of bytes dropped because the buffer was full
+	uint32_t GetDropCount() const
+	{ return m_drops; }
+
+	void Write(const char* buf, uint32_t len);
+
+	virtual void PrintBinary(char ch) override;
+	virtual void PrintString(const char* str) override;
+	virtual char BlockingRead() override;
+	virtual void Flush() override;
+
+protected:
+	virtual void OnTimer() override;
+
+	///@brief Returns true if output should go over the network
+	bool IsNetworkUp() const
+	{ return m_enabled && g_basetLinkUp; }
+
+	bool SendPacket(bool sendPartial);
+	uint32_t AppendRecord(uint8_t* payload, uint32_t offset, const char* prefix, uint32_t maxlen);
+	void DrainToFallback();
+
+	///@brief Gets a byte from the buffer, relative to the read pointer
+	char Peek(uint32_t i) const
+	{ return m_buffer[(m_tail + i) & (SYSLOG_BUFFER_SIZE - 1)]; }
+
+	///@brief UDP stack to send on
+	UDPProtocol* m_udp;
+
+	///@brief Where log output goes while the network is unavailable (may be null)
+	CharacterDevice* m_fallback;
+
+	///@brief True if syslog is turned on
+	bool m_enabled;
+
+	///@brief Address of the syslog server
+	IPv4Address m_serverAddress;
+
+	///@brief Tag sent before each message
+	const char* m_tag;
+
+	///@brief Log data waiting to be sent
+	char m_buffer[SYSLOG_BUFFER_SIZE];
+
+	///@brief Write index (free running)
+	uint32_t m_head;
+
+	///@brief Read index (free running)
+	uint32_t m_tail;
+
+	///@brief Write index as of the previous timer tick, to tell whether a partial line is still being written
+	uint32_t m_lastHead;
+
+	///@brief Bytes dropped because the buffer was full
+	uint32_t m_drops;
+
+	///@brief Value of m_drops we last sent a notice about
+	uint32_t m_reportedDrops;
+
+	///@brief Buffer position (free running) of the first gap not yet reported
+	uint32_t m_dropPosition;
+
+	///@brief Datagrams sent
+	uint32_t m_packets;
+};
+
+#endif
@@ -107,11 +107,18 @@ template<class T = GPIOPin>
 class ActiveLowResetDescriptorWithDelay : public ActiveLowResetDescriptor<T>
 {
 public:
-	ActiveLowResetDescriptorWithDelay(T& pin, const char* name, Timer& timer, uint16_t delay)
+	/**
+		@brief Creates the reset descriptor
+
+		@param pin		Reset pin
+		@param name		Name of the reset, for logging
+		@param delay	Time from releasing the reset until the device is ready, in g_timebase ticks (100us)
+	 */
+	ActiveLowResetDescriptorWithDelay(T& pin, const char* name, uint16_t delay)
 	: ActiveLowResetDescriptor<T>(pin, name)
-	, m_timer(timer)
 	, m_delay(delay)
 	, m_done(false)
+	, m_tstart(0)
 	{
 
 	}
@@ -121,30 +128,23 @@ public:
 		g_log("Releasing %s reset\n", ResetDescriptor<T>::m_name);
 		ResetDescriptor<T>::m_pin = 1;
 		m_done = false;
-		m_tstart = m_timer.GetCount();
+		m_tstart = g_timebase.GetTicks();
 	}
 
 	virtual bool IsReady() override
 	{
-		//Immediately report done on wrap
-		//TODO: cleaner handling?
-		auto tnow = m_timer.GetCount();
-		if(tnow < m_tstart)
-			m_done = true;
-
 		//Elapsed?
-		if(tnow > (m_tstart + m_delay) )
+		if(g_timebase.GetTicks() > (m_tstart + m_delay) )
 			m_done = true;
 
 		return m_done;
 	}
 
 protected:
-	Timer& m_timer;
 	uint16_t m_delay;
 
 	bool m_done;
-	uint32_t m_tstart;
+	uint64_t m_tstart;
 };
 
 /**
@@ -222,11 +222,18 @@ template<class T = GPIOPin>
 class ActiveHighResetDescriptorWithDelay : public ActiveHighResetDescriptor<T>
 {
 public:
-	ActiveHighResetDescriptorWithDelay(T& pin, const char* name, Timer& timer, uint16_t delay)
+	/**
+		@brief Creates the reset descriptor
+
+		@param pin		Reset pin
+		@param name		Name of the reset, for logging
+		@param delay	Time from releasing the reset until the device is ready, in g_timebase ticks (100us)
+	 */
+	ActiveHighResetDescriptorWithDelay(T& pin, const char* name, uint16_t delay)
 	: ActiveHighResetDescriptor<T>(pin, name)
-	, m_timer(timer)
 	, m_delay(delay)
 	, m_done(false)
+	, m_tstart(0)
 	{
 
 	}
@@ -236,30 +243,23 @@ public:
 		g_log("Releasing %s reset\n", ResetDescriptor<T>::m_name);
 		ResetDescriptor<T>::m_pin = 0;
 		m_done = false;
-		m_tstart = m_timer.GetCount();
+		m_tstart = g_timebase.GetTicks();
 	}
 
 	virtual bool IsReady() override
 	{
-		//Immediately report done on wrap
-		//TODO: cleaner handling?
-		auto tnow = m_timer.GetCount();
-		if(tnow < m_tstart)
-			m_done = true;
-
 		//Elapsed?
-		if(tnow > (m_tstart + m_delay) )
+		if(g_timebase.GetTicks() > (m_tstart + m_delay) )
 			m_done = true;
 
 		return m_done;
 	}
 
 protected:
-	Timer& m_timer;
 	uint16_t m_delay;
 
 	bool m_done;
-	uint32_t m_tstart;
+	uint64_t m_tstart;
 };
 
 #endif
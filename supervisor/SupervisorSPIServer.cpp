@@ -30,8 +30,9 @@
 #include "supervisor-common.h"
 #include "SupervisorSPIServer.h"
 
-SupervisorSPIServer::SupervisorSPIServer(SPI<64, 64>& spi)
+SupervisorSPIServer::SupervisorSPIServer(SPI<64, 64>& spi, bool alwaysReady)
 	: SPIServer(spi)
+	, Task(alwaysReady)
 {
 }
 
@@ -33,15 +33,27 @@
 #include <supervisor/SupervisorSPIRegisters.h>
 #include <helpers/SPIServer.h>
 
+/**
+	@brief SPI register interface of the supervisor
+
+	Polled by default. If the application's SPI interrupt handler calls Wake() whenever it queues an event, construct
+	with alwaysReady = false and the task only runs while there are events to process.
+ */
 class SupervisorSPIServer
 	: public SPIServer
 	, public Task
 {
 public:
-	SupervisorSPIServer(SPI<64, 64>& spi);
+	SupervisorSPIServer(SPI<64, 64>& spi, bool alwaysReady = true);
 
 	virtual void Iteration()
-	{ Poll(); }
+	{
+		Poll();
+
+		//Come back for anything Poll() didn't get to
+		if(m_spi.HasEvents())
+			Wake();
+	}
 
 protected:
 	virtual void OnCommand(uint8_t b) override;
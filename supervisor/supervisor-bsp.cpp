@@ -108,6 +108,47 @@ void BSP_InitClocks()
 	#endif
 }
 
+/**
+	@brief Arm a compare match on the log timer so the idle main loop can sleep until the next deadline
+
+	CC1 is left in frozen output compare mode, so this has no effect on any pins.
+ */
+bool BSP_ArmWakeupTimer(uint32_t target)
+{
+	#ifdef STM32L431
+		auto& tim = TIM2;
+		const uint32_t irq = 28;
+	#elif defined(STM32L031)
+		auto& tim = TIMER2;
+		const uint32_t irq = 15;
+	#else
+		#error unknown target device
+	#endif
+
+	tim.CCR1 = target;
+	tim.SR = ~0x2;			//clear stale CC1IF
+	tim.DIER |= 0x2;		//CC1IE
+	EnableWakeOnPendingIRQ(irq);
+	return true;
+}
+
+void BSP_DisarmWakeupTimer()
+{
+	#ifdef STM32L431
+		auto& tim = TIM2;
+		const uint32_t irq = 28;
+	#elif defined(STM32L031)
+		auto& tim = TIMER2;
+		const uint32_t irq = 15;
+	#else
+		#error unknown target device
+	#endif
+
+	tim.DIER &= ~0x2;
+	tim.SR = ~0x2;
+	ClearPendingIRQ(irq);
+}
+
 void BSP_InitLog()
 {
 	//Wait 10ms to avoid resets during shutdown from destroying diagnostic output
@@ -74,6 +74,7 @@ __attribute__((weak)) extern const IPv4Address g_defaultNetmask		= { .m_octets{2
 __attribute__((weak)) extern const IPv4Address g_defaultBroadcast	= { .m_octets{ 10,   2,   6, 255} };
 __attribute__((weak)) extern const IPv4Address g_defaultGateway		= { .m_octets{ 10,   2,   6, 252} };
 __attribute__((weak)) extern const IPv4Address g_defaultNtpServer	= { .m_octets{ 10,   2,   5,  26} };
+__attribute__((weak)) extern const IPv4Address g_defaultSyslogServer	= { .m_octets{ 10,   2,   5,  26} };
 
 void InitMacEEPROM()
 {
@@ -36,7 +36,7 @@ class IPAgingTask10Hz : public TimerTask
 {
 public:
 	IPAgingTask10Hz()
-		: TimerTask(0, 10 * 100)
+		: TimerTask(0, 10 * 100, TIMER_FIXED_RATE_CATCHUP)
 	{}
 
 protected:
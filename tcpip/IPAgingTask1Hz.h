@@ -36,7 +36,7 @@ class IPAgingTask1Hz : public TimerTask
 {
 public:
 	IPAgingTask1Hz()
-		: TimerTask(0, 10 * 1000)
+		: TimerTask(0, 10 * 1000, TIMER_FIXED_RATE_CATCHUP)
 	{}
 
 protected:
@@ -36,7 +36,7 @@ class PhyPollTask : public TimerTask
 {
 public:
 	PhyPollTask()
-		: TimerTask(0, 10 * 50)
+		: TimerTask(0, 10 * 50, TIMER_FIXED_RATE_SKIP)
 	{}
 
 protected:
@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+#
+# common-embedded-platform
+#
+# Copyright (c) 2026 Andrew D. Zonenberg and contributors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+# following conditions are met:
+#
+#    * Redistributions of source code must retain the above copyright notice, this list of conditions, and the
+#      following disclaimer.
+#
+#    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+#      following disclaimer in the documentation and/or other materials provided with the distribution.
+#
+#    * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+#      derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+# TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+# THE AUTHORS BE HELD LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+# BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+
+"""
+Decodes a DeferredLog record stream (see core/DeferredLog.h) back into text.
+
+Usage: deferred-log-decode.py firmware.elf [stream.bin]
+
+The stream is read from stdin if no file is given, so a serial port can be piped straight in. Format strings are looked
+up by address in the .logstrings section of the ELF, which must be the exact image that produced the stream.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC = 0xa5
+
+# printf conversion spec: flags, width, precision, length, conversion
+SPEC = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|L|z|j|t)?([diouxXcspfFeEgG%])')
+
+class LogStrings:
+	"""Format strings from the .logstrings section of an ELF file"""
+
+	def __init__(self, path):
+		with open(path, 'rb') as f:
+			elf = f.read()
+
+		if elf[0:4] != b'\x7fELF':
+			raise ValueError(f'{path} is not an ELF file')
+		if elf[5] != 1:
+			raise ValueError('only little endian ELF files are supported')
+
+		self.is64 = (elf[4] == 2)
+		self.ptrsize = 8 if self.is64 else 4
+
+		if self.is64:
+			shoff, = struct.unpack_from('<Q', elf, 0x28)
+			shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x3a)
+		else:
+			shoff, = struct.unpack_from('<I', elf, 0x20)
+			shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x2e)
+
+		sections = [self._section(elf, shoff + i*shentsize) for i in range(shnum)]
+		names = sections[shstrndx]
+		namedata = elf[names['offset'] : names['offset'] + names['size']]
+
+		self.base = None
+		for s in sections:
+			name = namedata[s['name'] : namedata.index(b'\0', s['name'])].decode()
+			if name == '.logstrings':
+				self.base = s['addr']
+				self.data = elf[s['offset'] : s['offset'] + s['size']]
+		if self.base is None:
+			raise ValueError(f'{path} has no .logstrings section')
+
+	def _section(self, elf, off):
+		if self.is64:
+			name, _, _, addr, offset, size = struct.unpack_from('<IIQQQQ', elf, off)
+		else:
+			name, _, _, addr, offset, size = struct.unpack_from('<IIIIII', elf, off)
+		return {'name': name, 'addr': addr, 'offset': offset, 'size': size}
+
+	def lookup(self, addr):
+		"""Gets the format string at a given address, or None if it's not in the section"""
+		off = addr - self.base
+		if off < 0 or off >= len(self.data):
+			return None
+		return self.data[off : self.data.index(b'\0', off)].decode(errors='replace')
+
+class ArgReader:
+	"""Pulls packed arguments out of a record, in the encoding used by DeferredLog::PackArg()"""
+
+	def __init__(self, data, ptrsize):
+		self.data = data
+		self.pos = 0
+		self.ptrsize = ptrsize
+
+	def _unpack(self, fmt):
+		v, = struct.unpack_from(fmt, self.data, self.pos)
+		self.pos += struct.calcsize(fmt)
+		return v
+
+	def integer(self, length, signed):
+		if length == 'll' or length == 'j' or (length in ('l', 'z', 't') and self.ptrsize == 8):
+			return self._unpack('<q' if signed else '<Q')
+		return self._unpack('<i' if signed else '<I')
+
+	def double(self):
+		return self._unpack('<d')
+
+	def pointer(self):
+		return self._unpack('<Q' if self.ptrsize == 8 else '<I')
+
+	def string(self):
+		n = self.data[self.pos]
+		s = self.data[self.pos + 1 : self.pos + 1 + n]
+		self.pos += 1 + n
+		return s.decode(errors='replace')
+
+def format_record(fmt, args):
+	"""Formats a record's arguments according to its printf format string"""
+
+	def convert(m):
+		flags, width, prec, length, conv = m.groups()
+		if conv == '%':
+			return '%'
+
+		if width == '*':
+			width = str(args.integer(None, True))
+		if prec == '*':
+			prec = str(args.integer(None, True))
+		spec = '%' + flags + (width or '') + ('.' + prec if prec is not None else '')
+
+		if conv in 'di':
+			return (spec + 'd') % args.integer(length, True)
+		if conv in 'ouxX':
+			return (spec + conv) % args.integer(length, False)
+		if conv == 'c':
+			return (spec + 'c') % chr(args.integer(None, False) & 0xff)
+		if conv == 's':
+			return (spec + 's') % args.string()
+		if conv == 'p':
+			return (spec + 's') % ('0x%x' % args.pointer())
+		return (spec + conv) % args.double()
+
+	return SPEC.sub(convert, fmt)
+
+def records(stream):
+	"""Yields the body of each record in a stream, resynchronizing on garbage"""
+	buf = b''
+	while True:
+		chunk = stream.read(4096)
+		if not chunk:
+			return
+		buf += chunk
+
+		while True:
+			start = buf.find(bytes([SYNC]))
+			if start < 0:
+				buf = b''
+				break
+			buf = buf[start:]
+			if len(buf) < 3:
+				break
+			length, = struct.unpack_from('<H', buf, 1)
+			if len(buf) < 3 + length:
+				break
+			yield buf[3 : 3 + length]
+			buf = buf[3 + length:]
+
+def main():
+	parser = argparse.ArgumentParser(description='Decode a DeferredLog binary stream')
+	parser.add_argument('elf', help='firmware ELF that produced the stream')
+	parser.add_argument('stream', nargs='?', help='captured stream (default: stdin)')
+	parser.add_argument('--tick-rate', type=float, default=10000, help='timestamp ticks per second (default 10000)')
+	args = parser.parse_args()
+
+	strings = LogStrings(args.elf)
+	stream = open(args.stream, 'rb') if args.stream else sys.stdin.buffer
+
+	#Timestamps are the low 32 bits of the timebase, so unwrap them
+	last = None
+	wraps = 0
+	for body in records(stream):
+		if len(body) < 8:
+			continue
+		addr, ts = struct.unpack_from('<II', body, 0)
+		if last is not None and ts < last:
+			wraps += 1
+		last = ts
+		t = ((wraps << 32) + ts) / args.tick_rate
+
+		fmt = strings.lookup(addr)
+		if fmt is None:
+			text = f'<unknown format string at 0x{addr:08x}>\n'
+		else:
+			try:
+				text = format_record(fmt, ArgReader(body[8:], strings.ptrsize))
+			except (struct.error, IndexError, TypeError, ValueError):
+				text = f'<bad arguments for "{fmt.rstrip()}">\n'
+
+		sys.stdout.write(f'[{t:12.4f}] {text}')
+		if not text.endswith('\n'):
+			sys.stdout.write('\n')
+
+if __name__ == '__main__':
+	main()